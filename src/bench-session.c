@@ -0,0 +1,204 @@
+// -------------------------------------------------------------------------------------------------
+//  File bench-session.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+
+// Platform includes
+#if defined(_WIN32) || defined(WIN32)
+
+    #include <windows.h>
+
+    #include "plt-windows.h"
+
+#else
+
+    #include <arpa/inet.h>
+
+    #include "plt-posix.h"
+
+#endif
+
+
+// Project headers
+#include "idn-session.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define MAX_PRODUCERS                   16          // Largest number of producer threads
+#define DEFAULT_FRAMES                  20000       // Number of frames per run
+#define DEFAULT_SAMPLES                 1000        // Number of samples per frame
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    IDNS_SESSION *session;                  // Session to feed
+    unsigned frameCnt;                      // Number of frames to produce
+    unsigned sampleCnt;                     // Number of samples per frame
+    uint64_t againCnt;                      // Number of begins refused (queue full)
+    int rc;                                 // Result
+
+} PRODUCER;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Producer threads
+// -------------------------------------------------------------------------------------------------
+
+static PLT_THREAD_RESULT PLT_THREAD_CALL producerThread(void *arg)
+{
+    PRODUCER *prd = (PRODUCER *)arg;
+
+    IDNS_WRITER *wr = idnsCreateWriter(prd->session);
+    if(!wr) { prd->rc = -1; return 0; }
+
+    for(unsigned k = 0; k < prd->frameCnt; k++)
+    {
+        // Note: Queue full, let the sender run (no sleep, the clock is virtual)
+        uint32_t frameNumber;
+        int rc;
+        while((rc = idnsBeginFrame(wr, &frameNumber)) == IDNS_AGAIN) { prd->againCnt++; plt_threadYield(); }
+        if(rc != IDNS_OK) { prd->rc = -1; break; }
+
+        // Circle, rotating with the frame number
+        for(unsigned i = 0; i < prd->sampleCnt; i++)
+        {
+            double a = (6.2831853 * i) / (prd->sampleCnt - 1) + frameNumber * 0.01;
+            idnsPutSample(wr, (int16_t)(20000 * cos(a)), (int16_t)(20000 * sin(a)), 255, (uint8_t)i, 0);
+        }
+
+        if(idnsSubmitFrame(wr) != IDNS_OK) { prd->rc = -1; break; }
+    }
+
+    idnsDestroyWriter(wr);
+    return 0;
+}
+
+
+static void logErrors(void *context, int level, const char *message)
+{
+    // Note: Errors only, the measurement prints its own lines
+    if(level == IDNS_LOG_ERROR) printf("%s\n", message);
+}
+
+
+static int runBench(uint32_t serverAddr, unsigned producerCnt, unsigned frameCnt, unsigned sampleCnt)
+{
+    IDNS_CONFIG cfg;
+    idnsInitConfig(&cfg);
+    cfg.serverAddr = serverAddr;
+    cfg.scanSpeed = sampleCnt * cfg.frameRate;
+    cfg.queueDepth = 4 * producerCnt;
+    cfg.logFunc = logErrors;
+
+    IDNS_SESSION *ssn = idnsOpen(&cfg);
+    if(!ssn) { printf("Session open failed\n"); return -1; }
+
+    // Split the frames across the producers
+    PRODUCER producers[MAX_PRODUCERS];
+    PLT_THREAD threads[MAX_PRODUCERS];
+    memset(producers, 0, sizeof(producers));
+
+    uint64_t startTime = plt_readMonoClockNS();
+    unsigned startedCnt = 0;
+    for(unsigned i = 0; i < producerCnt; i++)
+    {
+        producers[i].session = ssn;
+        producers[i].frameCnt = frameCnt / producerCnt + ((i < frameCnt % producerCnt) ? 1 : 0);
+        producers[i].sampleCnt = sampleCnt;
+        if(plt_threadCreate(&threads[i], producerThread, &producers[i])) break;
+        startedCnt++;
+    }
+
+    int rc = (startedCnt == producerCnt) ? 0 : -1;
+    uint64_t againCnt = 0;
+    for(unsigned i = 0; i < startedCnt; i++)
+    {
+        plt_threadJoin(threads[i]);
+        if(producers[i].rc) rc = -1;
+        againCnt += producers[i].againCnt;
+    }
+
+    // Note: Includes draining the queue (the sender is the last stage)
+    IDNS_STATS stats;
+    idnsGetStats(ssn, &stats);
+    if(idnsClose(ssn)) rc = -1;
+    double seconds = (double)(plt_readMonoClockNS() - startTime) / 1e9;
+
+    printf("%2u producers: %8.0f frames/s %6.1f Msamples/s  again %-8llu retry %-6u stall %-6u %s\n",
+           producerCnt, frameCnt / seconds, (double)frameCnt * sampleCnt / seconds / 1e6,
+           (unsigned long long)againCnt, stats.retryCnt, stats.stallCnt, rc ? "FAILED" : "");
+
+    return rc;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  Entry point
+// -------------------------------------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+    // Note: Frames are sent to the given server (default: loopback, nobody needs to listen)
+    const char *serverName = (argc > 1) ? argv[1] : "127.0.0.1";
+    unsigned frameCnt = (argc > 2) ? (unsigned)atoi(argv[2]) : DEFAULT_FRAMES;
+    unsigned sampleCnt = (argc > 3) ? (unsigned)atoi(argv[3]) : DEFAULT_SAMPLES;
+    unsigned maxProducers = (argc > 4) ? (unsigned)atoi(argv[4]) : 8;
+    if(!frameCnt || (sampleCnt < 2) || !maxProducers || (maxProducers > MAX_PRODUCERS))
+    {
+        printf("Usage: %s [server] [frames] [samples] [producers]\n", argv[0]);
+        return 1;
+    }
+
+    // Unpaced: The sender takes the frames as fast as they come
+    plt_enableVirtualClock();
+
+    printf("Session throughput, %u frames of %u samples (%u CPUs)\n", frameCnt, sampleCnt, plt_getCPUCount());
+
+    int rc = 0;
+    for(unsigned n = 1; n <= maxProducers; n <<= 1)
+    {
+        if(runBench(inet_addr(serverName), n, frameCnt, sampleCnt)) rc = 1;
+    }
+
+    return rc;
+}
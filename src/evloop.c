@@ -0,0 +1,426 @@
+// -------------------------------------------------------------------------------------------------
+//  File evloop.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+// Platform includes
+#if defined(_WIN32) || defined(WIN32)
+
+    #include <windows.h>
+
+    #include "plt-windows.h"
+
+#else
+
+    #include <errno.h>
+    #include <unistd.h>
+
+    #include "plt-posix.h"
+
+#endif
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#endif
+
+
+// Module header
+#include "evloop.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    int fd;                                 // Watched file descriptor, -1: unused entry
+    EVLOOP_IO_FUNC func;                    // Called when readable
+    void *context;                          // Callback context
+
+} EVLOOP_WATCH;
+
+
+struct _EVLOOP
+{
+    // Timer heap (earliest deadline first)
+    EVLOOP_TIMER **heap;
+    unsigned heapCnt;
+    unsigned heapCap;
+
+    // Watched file descriptors
+    EVLOOP_WATCH watches[EVLOOP_MAX_WATCHES];
+    unsigned watchCnt;
+
+    int fdEpoll;                            // epoll instance, -1: none (sleep until the next timer)
+    int fdTimer;                            // timerfd for the earliest deadline
+    uint64_t armedDeadline;                 // Deadline the timerfd is armed for, 0: disarmed
+    int stopFlag;                           // Leave evlRun()
+
+    EVLOOP_STATS stats;
+};
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+void idnLogError(const char *fmt, ...);
+void idnLogInfo(const char *fmt, ...);
+
+
+// -------------------------------------------------------------------------------------------------
+//  Tools
+// -------------------------------------------------------------------------------------------------
+
+static void heapPlace(EVLOOP *evl, unsigned pos, EVLOOP_TIMER *tmr)
+{
+    evl->heap[pos] = tmr;
+    tmr->heapPos = pos + 1;
+}
+
+
+static void heapUp(EVLOOP *evl, unsigned pos)
+{
+    EVLOOP_TIMER *tmr = evl->heap[pos];
+    while(pos > 0)
+    {
+        unsigned parent = (pos - 1) / 2;
+        if(evl->heap[parent]->deadline <= tmr->deadline) break;
+
+        heapPlace(evl, pos, evl->heap[parent]);
+        pos = parent;
+    }
+    heapPlace(evl, pos, tmr);
+}
+
+
+static void heapDown(EVLOOP *evl, unsigned pos)
+{
+    EVLOOP_TIMER *tmr = evl->heap[pos];
+    while(1)
+    {
+        unsigned child = (2 * pos) + 1;
+        if(child >= evl->heapCnt) break;
+        if((child + 1 < evl->heapCnt) && (evl->heap[child + 1]->deadline < evl->heap[child]->deadline)) child++;
+        if(tmr->deadline <= evl->heap[child]->deadline) break;
+
+        heapPlace(evl, pos, evl->heap[child]);
+        pos = child;
+    }
+    heapPlace(evl, pos, tmr);
+}
+
+
+static void heapRemove(EVLOOP *evl, EVLOOP_TIMER *tmr)
+{
+    unsigned pos = tmr->heapPos - 1;
+    tmr->heapPos = 0;
+
+    // Move the last timer into the gap and restore the heap order
+    evl->heapCnt--;
+    if(pos == evl->heapCnt) return;
+
+    EVLOOP_TIMER *moved = evl->heap[evl->heapCnt];
+    heapPlace(evl, pos, moved);
+    heapUp(evl, pos);
+    heapDown(evl, moved->heapPos - 1);
+}
+
+
+static void runTimers(EVLOOP *evl)
+{
+    // Expire all timers that are due. Note: Callbacks may arm timers again (even already expired)
+    uint64_t now = plt_getMonoTimeNS();
+    while(evl->heapCnt && (evl->heap[0]->deadline <= now) && !evl->stopFlag)
+    {
+        EVLOOP_TIMER *tmr = evl->heap[0];
+        heapRemove(evl, tmr);
+
+        uint64_t delay = now - tmr->deadline;
+        evl->stats.timerCnt++;
+        evl->stats.delaySum += delay;
+        if(delay > evl->stats.delayMax) evl->stats.delayMax = delay;
+
+        tmr->func(tmr->context, now);
+        now = plt_getMonoTimeNS();
+    }
+}
+
+
+#if defined(__linux__)
+
+static int waitEvents(EVLOOP *evl, int blockFlag)
+{
+    // Arm the timerfd for the earliest deadline (absolute, no drift). Only when it changed.
+    uint64_t deadline = evl->heapCnt ? evl->heap[0]->deadline : 0;
+    if(blockFlag && (deadline != evl->armedDeadline))
+    {
+        struct itimerspec its;
+        memset(&its, 0, sizeof(its));
+        its.it_value.tv_sec = (time_t)(deadline / 1000000000ull);
+        its.it_value.tv_nsec = (long)(deadline % 1000000000ull);
+
+        if(timerfd_settime(evl->fdTimer, TFD_TIMER_ABSTIME, &its, NULL) < 0)
+        {
+            idnLogError("[EVL] timerfd_settime() failed (error: %d)", errno);
+            return -1;
+        }
+        evl->armedDeadline = deadline;
+        evl->stats.rearmCnt++;
+    }
+
+    struct epoll_event events[EVLOOP_MAX_EVENTS];
+    int eventCnt = epoll_wait(evl->fdEpoll, events, EVLOOP_MAX_EVENTS, blockFlag ? -1 : 0);
+    if(eventCnt < 0)
+    {
+        if(errno == EINTR) return 0;
+        idnLogError("[EVL] epoll_wait() failed (error: %d)", errno);
+        return -1;
+    }
+
+    for(int i = 0; i < eventCnt; i++)
+    {
+        if(events[i].data.u32 == EVLOOP_MAX_WATCHES)
+        {
+            // Timer expired (consume the expiration count, the deadline passed)
+            uint64_t expirations;
+            if(read(evl->fdTimer, &expirations, sizeof(expirations)) < 0) { }
+            evl->armedDeadline = 0;
+            continue;
+        }
+
+        // Note: The entry may have been removed by an earlier callback of this wakeup
+        EVLOOP_WATCH *watch = &evl->watches[events[i].data.u32];
+        if(watch->fd < 0) continue;
+
+        evl->stats.ioCnt++;
+        watch->func(watch->context, watch->fd);
+    }
+
+    return 0;
+}
+
+#endif
+
+
+// -------------------------------------------------------------------------------------------------
+//  API functions
+// -------------------------------------------------------------------------------------------------
+
+EVLOOP *evlCreate(void)
+{
+    EVLOOP *evl = (EVLOOP *)calloc(1, sizeof(EVLOOP));
+    if(!evl) return (EVLOOP *)0;
+
+    for(unsigned i = 0; i < EVLOOP_MAX_WATCHES; i++) evl->watches[i].fd = -1;
+    evl->fdEpoll = -1;
+    evl->fdTimer = -1;
+
+#if defined(__linux__)
+    evl->fdEpoll = epoll_create1(EPOLL_CLOEXEC);
+    evl->fdTimer = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if((evl->fdEpoll < 0) || (evl->fdTimer < 0))
+    {
+        idnLogError("[EVL] epoll/timerfd not available (error: %d)", errno);
+        evlDestroy(evl);
+        return (EVLOOP *)0;
+    }
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = EVLOOP_MAX_WATCHES;
+    if(epoll_ctl(evl->fdEpoll, EPOLL_CTL_ADD, evl->fdTimer, &event) < 0)
+    {
+        idnLogError("[EVL] epoll_ctl() failed (error: %d)", errno);
+        evlDestroy(evl);
+        return (EVLOOP *)0;
+    }
+#endif
+
+    return evl;
+}
+
+
+void evlDestroy(EVLOOP *evl)
+{
+    if(!evl) return;
+
+    // Note: Timers are owned by the caller, just forget about them
+    for(unsigned i = 0; i < evl->heapCnt; i++) evl->heap[i]->heapPos = 0;
+
+#if defined(__linux__)
+    if(evl->fdTimer >= 0) close(evl->fdTimer);
+    if(evl->fdEpoll >= 0) close(evl->fdEpoll);
+#endif
+
+    if(evl->heap) free(evl->heap);
+    free(evl);
+}
+
+
+void evlTimerInit(EVLOOP_TIMER *tmr, EVLOOP_TIMER_FUNC func, void *context)
+{
+    memset(tmr, 0, sizeof(EVLOOP_TIMER));
+    tmr->func = func;
+    tmr->context = context;
+}
+
+
+int evlTimerArm(EVLOOP *evl, EVLOOP_TIMER *tmr, uint64_t deadline)
+{
+    // Already armed: Move
+    if(tmr->heapPos)
+    {
+        uint64_t previous = tmr->deadline;
+        tmr->deadline = deadline;
+        if(deadline < previous) heapUp(evl, tmr->heapPos - 1);
+        else heapDown(evl, tmr->heapPos - 1);
+        return 0;
+    }
+
+    if(evl->heapCnt == evl->heapCap)
+    {
+        unsigned heapCap = evl->heapCap ? 2 * evl->heapCap : 64;
+        EVLOOP_TIMER **heap = (EVLOOP_TIMER **)realloc(evl->heap, heapCap * sizeof(EVLOOP_TIMER *));
+        if(!heap) return -1;
+
+        evl->heap = heap;
+        evl->heapCap = heapCap;
+    }
+
+    tmr->deadline = deadline;
+    heapPlace(evl, evl->heapCnt++, tmr);
+    heapUp(evl, evl->heapCnt - 1);
+
+    return 0;
+}
+
+
+void evlTimerCancel(EVLOOP *evl, EVLOOP_TIMER *tmr)
+{
+    if(tmr->heapPos) heapRemove(evl, tmr);
+}
+
+
+int evlWatch(EVLOOP *evl, int fd, EVLOOP_IO_FUNC func, void *context)
+{
+#if defined(__linux__)
+    unsigned index = 0;
+    while((index < EVLOOP_MAX_WATCHES) && (evl->watches[index].fd >= 0)) index++;
+    if(index == EVLOOP_MAX_WATCHES) return -1;
+
+    struct epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u32 = index;
+    if(epoll_ctl(evl->fdEpoll, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        idnLogError("[EVL] epoll_ctl() failed (error: %d)", errno);
+        return -1;
+    }
+
+    evl->watches[index].fd = fd;
+    evl->watches[index].func = func;
+    evl->watches[index].context = context;
+    evl->watchCnt++;
+    return 0;
+#else
+    idnLogError("[EVL] Watching file descriptors not supported on this platform");
+    return -1;
+#endif
+}
+
+
+void evlUnwatch(EVLOOP *evl, int fd)
+{
+    for(unsigned i = 0; i < EVLOOP_MAX_WATCHES; i++)
+    {
+        if(evl->watches[i].fd != fd) continue;
+
+#if defined(__linux__)
+        epoll_ctl(evl->fdEpoll, EPOLL_CTL_DEL, fd, NULL);
+#endif
+        evl->watches[i].fd = -1;
+        evl->watchCnt--;
+        break;
+    }
+}
+
+
+int evlRun(EVLOOP *evl)
+{
+    // Run until stopped or nothing left to wait for
+    evl->stopFlag = 0;
+    while(!evl->stopFlag)
+    {
+        runTimers(evl);
+        if(evl->stopFlag || (!evl->heapCnt && !evl->watchCnt)) break;
+
+        evl->stats.wakeupCnt++;
+
+#if defined(__linux__)
+        if(!plt_isVirtualClock() || !evl->heapCnt)
+        {
+            if(waitEvents(evl, 1)) return -1;
+            continue;
+        }
+#endif
+
+        // Virtual clock (or no epoll): Sleep until the next timer (instantly on the virtual clock)
+        plt_sleepUntilNS(evl->heap[0]->deadline);
+
+#if defined(__linux__)
+        // Serve the file descriptors that became ready meanwhile
+        if(evl->watchCnt && waitEvents(evl, 0)) return -1;
+#endif
+    }
+
+    return 0;
+}
+
+
+void evlStop(EVLOOP *evl)
+{
+    evl->stopFlag = 1;
+}
+
+
+void evlGetStats(EVLOOP *evl, EVLOOP_STATS *stats)
+{
+    memcpy(stats, &evl->stats, sizeof(EVLOOP_STATS));
+}
@@ -0,0 +1,100 @@
+// -------------------------------------------------------------------------------------------------
+//  File evloop.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+#ifndef EVLOOP_H
+#define EVLOOP_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define EVLOOP_MAX_WATCHES              16          // Number of watched file descriptors
+#define EVLOOP_MAX_EVENTS               16          // Number of events taken per wakeup
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct _EVLOOP EVLOOP;
+
+typedef void (* EVLOOP_TIMER_FUNC)(void *context, uint64_t now);
+typedef void (* EVLOOP_IO_FUNC)(void *context, int fd);
+
+typedef struct
+{
+    uint64_t deadline;                      // Expiry time (monotonic time, ns)
+    unsigned heapPos;                       // Position in the timer heap + 1, 0: not armed
+    EVLOOP_TIMER_FUNC func;                 // Called on expiry (timer no longer armed)
+    void *context;                          // Callback context
+
+} EVLOOP_TIMER;
+
+typedef struct
+{
+    uint64_t wakeupCnt;                     // Number of times the loop woke up
+    uint64_t timerCnt;                      // Number of expired timers
+    uint64_t ioCnt;                         // Number of file descriptor events
+    uint64_t rearmCnt;                      // Number of wakeup timer changes
+    uint64_t delaySum;                      // Sum of all timer callback delays (ns)
+    uint64_t delayMax;                      // Maximum timer callback delay (ns)
+
+} EVLOOP_STATS;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+// Note: Single thread. Timers are embedded by the caller (no allocation per timer). On Linux, the
+// loop sleeps in epoll_wait() on a timerfd for the earliest timer. Elsewhere, the loop sleeps until
+// the earliest timer and file descriptors cannot be watched.
+EVLOOP *evlCreate(void);
+void evlDestroy(EVLOOP *evl);
+
+void evlTimerInit(EVLOOP_TIMER *tmr, EVLOOP_TIMER_FUNC func, void *context);
+int evlTimerArm(EVLOOP *evl, EVLOOP_TIMER *tmr, uint64_t deadline);
+void evlTimerCancel(EVLOOP *evl, EVLOOP_TIMER *tmr);
+
+int evlWatch(EVLOOP *evl, int fd, EVLOOP_IO_FUNC func, void *context);
+void evlUnwatch(EVLOOP *evl, int fd);
+
+int evlRun(EVLOOP *evl);
+void evlStop(EVLOOP *evl);
+
+void evlGetStats(EVLOOP *evl, EVLOOP_STATS *stats);
+
+
+#endif
@@ -0,0 +1,310 @@
+// -------------------------------------------------------------------------------------------------
+//  File frame-queue.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+// Platform includes
+#if defined(_WIN32) || defined(WIN32)
+
+    #include <windows.h>
+
+    #include "plt-windows.h"
+
+#else
+
+    #include "plt-posix.h"
+
+#endif
+
+
+// Module header
+#include "frame-queue.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+struct _FRAME_QUEUE
+{
+    unsigned depth;                         // Number of slots
+    FRAME_QUEUE_SLOT *slots;                // Slot array
+
+    // Ring indices (free running). Each one written by its owner only, read by the other side.
+    volatile uint32_t head;                 // Frames taken (consumer)
+    volatile uint32_t tail;                 // Frames queued (producer)
+    volatile uint32_t closedFlag;           // Producer done, no more frames
+    volatile uint32_t abortFlag;            // Consumer done, drop further frames
+
+    // Sleeping (only when the queue is full/empty). Note: The lock is not used to pass frames.
+    volatile uint32_t producerWaiting;      // Producer sleeps on spaceCond
+    volatile uint32_t consumerWaiting;      // Consumer sleeps on dataCond
+    PLT_MUTEX mutex;
+    PLT_COND spaceCond;
+    PLT_COND dataCond;
+
+    // Statistics, producer side
+    uint64_t putCnt;
+    uint32_t fullCnt;
+
+    // Statistics, consumer side
+    uint64_t getCnt;
+    uint64_t occupancySum;
+    unsigned occupancyMin;
+    uint32_t underrunCnt;
+    int underrunFlag;                       // Underrun of the current frame already counted
+};
+
+
+// -------------------------------------------------------------------------------------------------
+//  Tools
+// -------------------------------------------------------------------------------------------------
+
+static void wakeUp(FRAME_QUEUE *frq, volatile uint32_t *waitingFlag, PLT_COND *cond)
+{
+    // Note: The index update (by the caller) and the flag check are sequentially consistent.
+    // Either the other side sees the new index before sleeping or we see its flag. Taking the
+    // lock makes sure the other side is already waiting on the condition.
+    if(plt_atomicLoad32(waitingFlag))
+    {
+        plt_mutexLock(&frq->mutex);
+        plt_condSignal(cond);
+        plt_mutexUnlock(&frq->mutex);
+    }
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  API functions
+// -------------------------------------------------------------------------------------------------
+
+FRAME_QUEUE *frqCreate(unsigned depth)
+{
+    if(depth == 0) depth = 1;
+    if(depth > FRAMEQUEUE_MAX_DEPTH) depth = FRAMEQUEUE_MAX_DEPTH;
+
+    FRAME_QUEUE *frq = (FRAME_QUEUE *)calloc(1, sizeof(FRAME_QUEUE));
+    if(!frq) return (FRAME_QUEUE *)0;
+
+    frq->slots = (FRAME_QUEUE_SLOT *)calloc(depth, sizeof(FRAME_QUEUE_SLOT));
+    if(!frq->slots) { free(frq); return (FRAME_QUEUE *)0; }
+
+    frq->depth = depth;
+    frq->occupancyMin = depth;
+    plt_mutexInit(&frq->mutex);
+    plt_condInit(&frq->spaceCond);
+    plt_condInit(&frq->dataCond);
+
+    return frq;
+}
+
+
+void frqDestroy(FRAME_QUEUE *frq)
+{
+    if(!frq) return;
+
+    for(unsigned i = 0; i < frq->depth; i++)
+    {
+        if(frq->slots[i].bufferPtr) free(frq->slots[i].bufferPtr);
+    }
+
+    plt_condDestroy(&frq->dataCond);
+    plt_condDestroy(&frq->spaceCond);
+    plt_mutexDestroy(&frq->mutex);
+    free(frq->slots);
+    free(frq);
+}
+
+
+int frqReserve(FRAME_QUEUE *frq, unsigned bufferLen)
+{
+    // Allocate and touch the slot buffers upfront (no allocation or page faults while streaming)
+    for(unsigned i = 0; i < frq->depth; i++)
+    {
+        FRAME_QUEUE_SLOT *slot = &frq->slots[i];
+        if(slot->bufferLen >= bufferLen) continue;
+
+        uint8_t *bufferPtr = (uint8_t *)realloc(slot->bufferPtr, bufferLen);
+        if(!bufferPtr) return -1;
+
+        memset(bufferPtr, 0, bufferLen);
+        slot->bufferPtr = bufferPtr;
+        slot->bufferLen = bufferLen;
+    }
+
+    return 0;
+}
+
+
+FRAME_QUEUE_SLOT *frqPutBegin(FRAME_QUEUE *frq)
+{
+    uint32_t tail = frq->tail;
+
+    // Wait for a free slot
+    if((tail - plt_atomicLoad32(&frq->head)) >= frq->depth)
+    {
+        frq->fullCnt++;
+
+        plt_mutexLock(&frq->mutex);
+        plt_atomicStore32(&frq->producerWaiting, 1);
+        while(((tail - plt_atomicLoad32(&frq->head)) >= frq->depth) && !plt_atomicLoad32(&frq->abortFlag))
+        {
+            plt_condWait(&frq->spaceCond, &frq->mutex);
+        }
+        plt_atomicStore32(&frq->producerWaiting, 0);
+        plt_mutexUnlock(&frq->mutex);
+    }
+
+    // Consumer gone - nothing to put the frame for
+    if(plt_atomicLoad32(&frq->abortFlag)) return (FRAME_QUEUE_SLOT *)0;
+
+    return &frq->slots[tail % frq->depth];
+}
+
+
+FRAME_QUEUE_SLOT *frqTryPutBegin(FRAME_QUEUE *frq, int *fullPtr)
+{
+    uint32_t tail = frq->tail;
+
+    // Never waits: No slot either when full (flagged) or when the consumer is gone
+    *fullPtr = 0;
+    if(plt_atomicLoad32(&frq->abortFlag)) return (FRAME_QUEUE_SLOT *)0;
+    if((tail - plt_atomicLoad32(&frq->head)) >= frq->depth)
+    {
+        frq->fullCnt++;
+        *fullPtr = 1;
+        return (FRAME_QUEUE_SLOT *)0;
+    }
+
+    return &frq->slots[tail % frq->depth];
+}
+
+
+void frqPutEnd(FRAME_QUEUE *frq)
+{
+    // Publish the slot (all slot writes happen before the index store)
+    plt_atomicStore32(&frq->tail, frq->tail + 1);
+    frq->putCnt++;
+
+    wakeUp(frq, &frq->consumerWaiting, &frq->dataCond);
+}
+
+
+void frqClose(FRAME_QUEUE *frq)
+{
+    plt_atomicStore32(&frq->closedFlag, 1);
+    wakeUp(frq, &frq->consumerWaiting, &frq->dataCond);
+}
+
+
+FRAME_QUEUE_SLOT *frqGetBegin(FRAME_QUEUE *frq)
+{
+    return frqGetBeginUntil(frq, 0, (int *)0);
+}
+
+
+FRAME_QUEUE_SLOT *frqGetBeginUntil(FRAME_QUEUE *frq, uint64_t nsDeadline, int *timeoutPtr)
+{
+    uint32_t head = frq->head;
+    uint32_t occupancy = plt_atomicLoad32(&frq->tail) - head;
+    if(timeoutPtr) *timeoutPtr = 0;
+
+    // Wait for a frame
+    if(occupancy == 0)
+    {
+        // Sender ran dry while the stream is still going (count once per frame, not per timeout)
+        if(frq->getCnt && !frq->underrunFlag && !plt_atomicLoad32(&frq->closedFlag))
+        {
+            frq->underrunCnt++;
+            frq->underrunFlag = 1;
+        }
+
+        int timeoutFlag = 0;
+        plt_mutexLock(&frq->mutex);
+        plt_atomicStore32(&frq->consumerWaiting, 1);
+        while((plt_atomicLoad32(&frq->tail) == head) && !plt_atomicLoad32(&frq->closedFlag) && !timeoutFlag)
+        {
+            if(!nsDeadline) plt_condWait(&frq->dataCond, &frq->mutex);
+            else timeoutFlag = plt_condWaitUntilNS(&frq->dataCond, &frq->mutex, nsDeadline);
+        }
+        plt_atomicStore32(&frq->consumerWaiting, 0);
+        plt_mutexUnlock(&frq->mutex);
+
+        // Note: The producer updates the index before the closed flag
+        occupancy = plt_atomicLoad32(&frq->tail) - head;
+        if(occupancy == 0)
+        {
+            if(timeoutPtr && !plt_atomicLoad32(&frq->closedFlag)) *timeoutPtr = timeoutFlag;
+            return (FRAME_QUEUE_SLOT *)0;
+        }
+    }
+
+    frq->occupancySum += occupancy;
+    if(occupancy < frq->occupancyMin) frq->occupancyMin = occupancy;
+
+    return &frq->slots[head % frq->depth];
+}
+
+
+void frqGetEnd(FRAME_QUEUE *frq)
+{
+    // Release the slot back to the producer
+    plt_atomicStore32(&frq->head, frq->head + 1);
+    frq->getCnt++;
+    frq->underrunFlag = 0;
+
+    wakeUp(frq, &frq->producerWaiting, &frq->spaceCond);
+}
+
+
+void frqAbort(FRAME_QUEUE *frq)
+{
+    plt_atomicStore32(&frq->abortFlag, 1);
+    wakeUp(frq, &frq->producerWaiting, &frq->spaceCond);
+}
+
+
+void frqGetStats(FRAME_QUEUE *frq, FRAME_QUEUE_STATS *stats)
+{
+    memset(stats, 0, sizeof(FRAME_QUEUE_STATS));
+
+    stats->putCnt = frq->putCnt;
+    stats->getCnt = frq->getCnt;
+    stats->occupancySum = frq->occupancySum;
+    stats->occupancyMin = frq->getCnt ? frq->occupancyMin : 0;
+    stats->depth = frq->depth;
+    stats->underrunCnt = frq->underrunCnt;
+    stats->fullCnt = frq->fullCnt;
+}
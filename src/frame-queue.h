@@ -0,0 +1,99 @@
+// -------------------------------------------------------------------------------------------------
+//  File frame-queue.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+#ifndef FRAME_QUEUE_H
+#define FRAME_QUEUE_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define FRAMEQUEUE_DEFAULT_DEPTH        4           // Number of frames decoded ahead of the sender
+#define FRAMEQUEUE_MAX_DEPTH            64
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct _FRAME_QUEUE FRAME_QUEUE;
+
+typedef struct
+{
+    uint8_t *bufferPtr;                     // Frame buffer (owned by the slot, swapped on put)
+    unsigned bufferLen;                     // Length of the frame buffer
+    unsigned dataOffset;                    // Offset of the encoded data (headroom for headers)
+    unsigned dataLen;                       // Length of the encoded data
+
+} FRAME_QUEUE_SLOT;
+
+typedef struct
+{
+    uint64_t putCnt;                        // Number of frames queued by the producer
+    uint64_t getCnt;                        // Number of frames taken by the consumer
+    uint64_t occupancySum;                  // Sum of the queue fill levels seen by the consumer
+    unsigned occupancyMin;                  // Minimum fill level seen by the consumer
+    unsigned depth;                         // Queue capacity
+    uint32_t underrunCnt;                   // Consumer found the queue empty (after the first frame)
+    uint32_t fullCnt;                       // Producer found the queue full
+
+} FRAME_QUEUE_STATS;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+// Note: Single producer, single consumer. Put/get block only when the queue is full/empty.
+// frqGetBeginUntil() gives up at the deadline (monotonic time, 0: none) and flags the timeout,
+// frqTryPutBegin() returns right away and flags a full queue.
+FRAME_QUEUE *frqCreate(unsigned depth);
+void frqDestroy(FRAME_QUEUE *frq);
+int frqReserve(FRAME_QUEUE *frq, unsigned bufferLen);
+
+FRAME_QUEUE_SLOT *frqPutBegin(FRAME_QUEUE *frq);
+FRAME_QUEUE_SLOT *frqTryPutBegin(FRAME_QUEUE *frq, int *fullPtr);
+void frqPutEnd(FRAME_QUEUE *frq);
+void frqClose(FRAME_QUEUE *frq);
+
+FRAME_QUEUE_SLOT *frqGetBegin(FRAME_QUEUE *frq);
+FRAME_QUEUE_SLOT *frqGetBeginUntil(FRAME_QUEUE *frq, uint64_t nsDeadline, int *timeoutPtr);
+void frqGetEnd(FRAME_QUEUE *frq);
+void frqAbort(FRAME_QUEUE *frq);
+
+void frqGetStats(FRAME_QUEUE *frq, FRAME_QUEUE_STATS *stats);
+
+
+#endif
@@ -0,0 +1,354 @@
+// -------------------------------------------------------------------------------------------------
+//  File frame.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+
+// Module header
+#include "frame.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define XYRGB_SAMPLE_SIZE               7
+
+
+// -------------------------------------------------------------------------------------------------
+//  Tools
+// -------------------------------------------------------------------------------------------------
+
+static int compareDescending(const void *a, const void *b)
+{
+    float fa = *(const float *)a, fb = *(const float *)b;
+    return (fa < fb) ? 1 : ((fa > fb) ? -1 : 0);
+}
+
+
+static float segmentDistance2(const FRAME_SOA *frm, unsigned i, unsigned a, unsigned b)
+{
+    // Squared distance of sample i to the segment from sample a to sample b
+    float ax = frm->x[a], ay = frm->y[a];
+    float dx = frm->x[b] - ax, dy = frm->y[b] - ay;
+    float px = frm->x[i] - ax, py = frm->y[i] - ay;
+
+    float len2 = (dx * dx) + (dy * dy);
+    float t = (len2 > 0.0f) ? ((px * dx) + (py * dy)) / len2 : 0.0f;
+    if(t < 0.0f) t = 0.0f;
+    if(t > 1.0f) t = 1.0f;
+
+    float ex = px - (t * dx), ey = py - (t * dy);
+    return (ex * ex) + (ey * ey);
+}
+
+
+static int16_t toPosition(float value)
+{
+    long l = lrintf(value);
+    if(l < -32768) return -32768;
+    if(l > 32767) return 32767;
+
+    return (int16_t)l;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  API functions
+// -------------------------------------------------------------------------------------------------
+
+void frmInit(FRAME_SOA *frm)
+{
+    memset(frm, 0, sizeof(FRAME_SOA));
+}
+
+
+void frmFree(FRAME_SOA *frm)
+{
+    if(frm->x) free(frm->x);
+    if(frm->y) free(frm->y);
+    if(frm->r) free(frm->r);
+    if(frm->g) free(frm->g);
+    if(frm->b) free(frm->b);
+    if(frm->pos) free(frm->pos);
+    if(frm->blankCnt) free(frm->blankCnt);
+    if(frm->weight) free(frm->weight);
+    if(frm->range) free(frm->range);
+
+    memset(frm, 0, sizeof(FRAME_SOA));
+}
+
+
+int frmReserve(FRAME_SOA *frm, unsigned sampleCnt)
+{
+    if(frm->capacity >= sampleCnt) return 0;
+
+    // Grow in steps (avoid frequent reallocation with varying frame sizes)
+    unsigned capacity = frm->capacity ? frm->capacity : 0x400;
+    while(capacity < sampleCnt) capacity *= 2;
+
+    float *x = (float *)realloc(frm->x, capacity * sizeof(float));
+    if(x) frm->x = x;
+    float *y = (float *)realloc(frm->y, capacity * sizeof(float));
+    if(y) frm->y = y;
+    uint8_t *r = (uint8_t *)realloc(frm->r, capacity);
+    if(r) frm->r = r;
+    uint8_t *g = (uint8_t *)realloc(frm->g, capacity);
+    if(g) frm->g = g;
+    uint8_t *b = (uint8_t *)realloc(frm->b, capacity);
+    if(b) frm->b = b;
+    float *pos = (float *)realloc(frm->pos, capacity * sizeof(float));
+    if(pos) frm->pos = pos;
+    uint32_t *blankCnt = (uint32_t *)realloc(frm->blankCnt, capacity * sizeof(uint32_t));
+    if(blankCnt) frm->blankCnt = blankCnt;
+    float *weight = (float *)realloc(frm->weight, capacity * sizeof(float));
+    if(weight) frm->weight = weight;
+    uint32_t *range = (uint32_t *)realloc(frm->range, 2 * capacity * sizeof(uint32_t));
+    if(range) frm->range = range;
+
+    if(!x || !y || !r || !g || !b || !pos || !blankCnt || !weight || !range) return -1;
+
+    frm->capacity = capacity;
+    return 0;
+}
+
+
+int frmLoadXYRGB(FRAME_SOA *frm, const uint8_t *samples, unsigned sampleCnt)
+{
+    if(frmReserve(frm, sampleCnt)) return -1;
+
+    // Deinterleave
+    for(unsigned i = 0; i < sampleCnt; i++)
+    {
+        const uint8_t *p = &samples[i * XYRGB_SAMPLE_SIZE];
+        frm->x[i] = (float)(int16_t)((p[0] << 8) | p[1]);
+        frm->y[i] = (float)(int16_t)((p[2] << 8) | p[3]);
+        frm->r[i] = p[4];
+        frm->g[i] = p[5];
+        frm->b[i] = p[6];
+    }
+
+    frm->sampleCnt = sampleCnt;
+    return 0;
+}
+
+
+void frmStoreXYRGB(const FRAME_SOA *frm, uint8_t *samples, unsigned colorShift)
+{
+    // Note: Color shift as in the frame encoder. The first samples are black, the last position
+    // is repeated for the shifted colors. Writes sampleCnt + colorShift samples.
+    unsigned totalCnt = frm->sampleCnt + colorShift;
+    for(unsigned i = 0; i < totalCnt; i++)
+    {
+        unsigned iPos = (i < frm->sampleCnt) ? i : frm->sampleCnt - 1;
+        int16_t x = toPosition(frm->x[iPos]);
+        int16_t y = toPosition(frm->y[iPos]);
+
+        uint8_t *p = &samples[i * XYRGB_SAMPLE_SIZE];
+        p[0] = (uint8_t)(x >> 8);
+        p[1] = (uint8_t)x;
+        p[2] = (uint8_t)(y >> 8);
+        p[3] = (uint8_t)y;
+
+        if(i < colorShift)
+        {
+            p[4] = 0;
+            p[5] = 0;
+            p[6] = 0;
+        }
+        else
+        {
+            p[4] = frm->r[i - colorShift];
+            p[5] = frm->g[i - colorShift];
+            p[6] = frm->b[i - colorShift];
+        }
+    }
+}
+
+
+int frmResample(FRAME_SOA *dst, FRAME_SOA *src, unsigned sampleCnt)
+{
+    // Retime the path to the given number of samples (same path, evenly stretched/compressed in time)
+    unsigned srcCnt = src->sampleCnt;
+    if((srcCnt < 2) || (sampleCnt < 2)) return -1;
+    if(frmReserve(dst, sampleCnt)) return -1;
+
+    // Blanked segments up to each source sample. Note: The color of a segment is the color of
+    // its end point (segment k runs from sample k-1 to sample k).
+    uint32_t *blankCnt = src->blankCnt;
+    blankCnt[0] = 0;
+    for(unsigned k = 1; k < srcCnt; k++)
+    {
+        blankCnt[k] = blankCnt[k - 1] + ((src->r[k] | src->g[k] | src->b[k]) == 0);
+    }
+
+    // Sample positions in source index space, last one exactly on the last source sample
+    float *pos = dst->pos;
+    float step = (float)(srcCnt - 1) / (float)(sampleCnt - 1);
+    for(unsigned j = 0; j < sampleCnt; j++) pos[j] = (float)j * step;
+    pos[sampleCnt - 1] = (float)(srcCnt - 1);
+
+    // Positions: Linear interpolation along the source path. Note: Loop over the source segments,
+    // the inner loop over the target samples within a segment is contiguous (vectorizes).
+    const float *sx = src->x, *sy = src->y;
+    float *dx = dst->x, *dy = dst->y;
+    unsigned j = 0;
+    for(unsigned k = 0; k < srcCnt - 1; k++)
+    {
+        unsigned jEnd = j;
+        float segEnd = (float)(k + 1);
+        while((jEnd < sampleCnt) && (pos[jEnd] < segEnd)) jEnd++;
+
+        float x0 = sx[k], y0 = sy[k];
+        float xd = sx[k + 1] - x0, yd = sy[k + 1] - y0;
+        float base = (float)k;
+        for(unsigned jj = j; jj < jEnd; jj++)
+        {
+            float f = pos[jj] - base;
+            dx[jj] = x0 + (f * xd);
+            dy[jj] = y0 + (f * yd);
+        }
+
+        j = jEnd;
+    }
+    for(; j < sampleCnt; j++)
+    {
+        dx[j] = sx[srcCnt - 1];
+        dy[j] = sy[srcCnt - 1];
+    }
+
+    // Colors: End point color of the covering source segment. Blanked in case any of the
+    // covered source segments is blanked (never draw across a blanked move when compressing).
+    dst->r[0] = src->r[0];
+    dst->g[0] = src->g[0];
+    dst->b[0] = src->b[0];
+    for(unsigned j = 1; j < sampleCnt; j++)
+    {
+        unsigned kStart = (unsigned)pos[j - 1];
+        unsigned kEnd = (unsigned)ceilf(pos[j]);
+        if(kEnd > srcCnt - 1) kEnd = srcCnt - 1;
+
+        uint8_t visible = (blankCnt[kEnd] == blankCnt[kStart]) ? 0xFF : 0x00;
+        dst->r[j] = src->r[kEnd] & visible;
+        dst->g[j] = src->g[kEnd] & visible;
+        dst->b[j] = src->b[kEnd] & visible;
+    }
+
+    dst->sampleCnt = sampleCnt;
+    return 0;
+}
+
+
+int frmDecimate(FRAME_SOA *dst, FRAME_SOA *src, unsigned maxCnt)
+{
+    // Reduce the frame to at most maxCnt samples (path-preserving). Douglas-Peucker runs on each
+    // run of equal color (lit or blanked). The run ends (color edges) are always kept, so the
+    // result may exceed maxCnt. Returns the number of samples.
+    unsigned srcCnt = src->sampleCnt;
+    if(frmReserve(src, srcCnt) || frmReserve(dst, srcCnt)) return -1;
+
+    const uint8_t *r = src->r, *g = src->g, *b = src->b;
+    float *weight = src->weight;
+    uint32_t *range = src->range;
+
+    // Color edges: The color of a segment is the color of its end point
+    for(unsigned k = 0; k < srcCnt; k++)
+    {
+        int edge = (k == 0) || (k == srcCnt - 1) || (r[k] != r[k + 1]) || (g[k] != g[k + 1]) || (b[k] != b[k + 1]);
+        weight[k] = edge ? HUGE_VALF : 0.0f;
+    }
+
+    // Runs between the edges (with samples in between)
+    unsigned rangeCnt = 0, lastEdge = 0;
+    for(unsigned k = 1; k < srcCnt; k++)
+    {
+        if(weight[k] != HUGE_VALF) continue;
+        if(k - lastEdge > 1)
+        {
+            range[2 * rangeCnt] = lastEdge;
+            range[(2 * rangeCnt) + 1] = k;
+            rangeCnt++;
+        }
+        lastEdge = k;
+    }
+
+    // Douglas-Peucker (iterative). The significance of a sample is its distance when chosen as
+    // split point, limited by the significance of the enclosing split (so a threshold yields a
+    // consistent Douglas-Peucker result).
+    while(rangeCnt)
+    {
+        rangeCnt--;
+        unsigned first = range[2 * rangeCnt], last = range[(2 * rangeCnt) + 1];
+
+        unsigned split = first;
+        float splitDist = -1.0f;
+        for(unsigned i = first + 1; i < last; i++)
+        {
+            float d = segmentDistance2(src, i, first, last);
+            if(d > splitDist) { splitDist = d; split = i; }
+        }
+
+        float parent = (weight[first] < weight[last]) ? weight[first] : weight[last];
+        weight[split] = (splitDist < parent) ? splitDist : parent;
+
+        if(split - first > 1) { range[2 * rangeCnt] = first; range[(2 * rangeCnt) + 1] = split; rangeCnt++; }
+        if(last - split > 1) { range[2 * rangeCnt] = split; range[(2 * rangeCnt) + 1] = last; rangeCnt++; }
+    }
+
+    // Threshold: Keep the most significant samples that fit into the budget
+    float threshold = -1.0f;
+    if((srcCnt > maxCnt) && maxCnt)
+    {
+        float *sorted = dst->pos;
+        memcpy(sorted, weight, srcCnt * sizeof(float));
+        qsort(sorted, srcCnt, sizeof(float), compareDescending);
+        threshold = sorted[maxCnt - 1];
+    }
+
+    // Copy the kept samples. Note: Ties at the threshold are dropped (stay within the budget)
+    unsigned dstCnt = 0;
+    for(unsigned k = 0; k < srcCnt; k++)
+    {
+        if((weight[k] <= threshold) && (weight[k] != HUGE_VALF)) continue;
+
+        dst->x[dstCnt] = src->x[k];
+        dst->y[dstCnt] = src->y[k];
+        dst->r[dstCnt] = r[k];
+        dst->g[dstCnt] = g[k];
+        dst->b[dstCnt] = b[k];
+        dstCnt++;
+    }
+
+    dst->sampleCnt = dstCnt;
+    return (int)dstCnt;
+}
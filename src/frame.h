@@ -0,0 +1,78 @@
+// -------------------------------------------------------------------------------------------------
+//  File frame.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+#ifndef FRAME_H
+#define FRAME_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+// Frame samples in structure-of-arrays layout (one array per channel, friendly to vectorization)
+typedef struct
+{
+    unsigned sampleCnt;                     // Number of samples
+    unsigned capacity;                      // Number of samples allocated
+
+    float *x;                               // X position
+    float *y;                               // Y position
+    uint8_t *r;                             // Red
+    uint8_t *g;                             // Green
+    uint8_t *b;                             // Blue
+
+    float *pos;                             // Scratch: Resampling positions (source index space)
+    uint32_t *blankCnt;                     // Scratch: Number of blanked segments up to a sample
+    float *weight;                          // Scratch: Decimation significance of a sample
+    uint32_t *range;                        // Scratch: Decimation ranges (two entries per sample)
+
+} FRAME_SOA;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+void frmInit(FRAME_SOA *frm);
+void frmFree(FRAME_SOA *frm);
+int frmReserve(FRAME_SOA *frm, unsigned sampleCnt);
+
+// Note: Sample bytes as in IDN XYRGB sample chunks (16 bit X/Y big endian, 8 bit R/G/B)
+int frmLoadXYRGB(FRAME_SOA *frm, const uint8_t *samples, unsigned sampleCnt);
+void frmStoreXYRGB(const FRAME_SOA *frm, uint8_t *samples, unsigned colorShift);
+
+int frmResample(FRAME_SOA *dst, FRAME_SOA *src, unsigned sampleCnt);
+int frmDecimate(FRAME_SOA *dst, FRAME_SOA *src, unsigned maxCnt);
+
+
+#endif
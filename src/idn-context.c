@@ -0,0 +1,1324 @@
+// -------------------------------------------------------------------------------------------------
+//  File idn-context.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created (stream encoding and pacing moved out of main.c)
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdint.h>
+
+
+// Platform includes
+#if defined(_WIN32) || defined(WIN32)
+
+    #include <windows.h>
+
+    #include "plt-windows.h"
+
+#else
+
+    #include <stdlib.h>
+    #include <string.h>
+    #include <arpa/inet.h>
+
+    #include "plt-posix.h"
+
+#endif
+
+
+// Module header
+#include "idn-context.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Tools
+// -------------------------------------------------------------------------------------------------
+
+static IDN_LOG_FUNC logFunc = (IDN_LOG_FUNC)0;
+static void *logContext = (void *)0;
+
+
+static void logMessage(int level, const char *fmt, va_list arg_ptr)
+{
+    // Note: Without log function (host application did not set one), the library is silent
+    IDN_LOG_FUNC func = logFunc;
+    if(!func) return;
+
+    char message[MAX_LOG_MESSAGE];
+    vsnprintf(message, sizeof(message), fmt, arg_ptr);
+    func(logContext, level, message);
+}
+
+
+void idnSetLogFunc(IDN_LOG_FUNC func, void *context)
+{
+    logContext = context;
+    logFunc = func;
+}
+
+
+void idnLogError(const char *fmt, ...)
+{
+    va_list arg_ptr;
+    va_start(arg_ptr, fmt);
+    logMessage(IDN_LOG_ERROR, fmt, arg_ptr);
+    va_end(arg_ptr);
+}
+
+
+void idnLogInfo(const char *fmt, ...)
+{
+    va_list arg_ptr;
+    va_start(arg_ptr, fmt);
+    logMessage(IDN_LOG_INFO, fmt, arg_ptr);
+    va_end(arg_ptr);
+}
+
+
+int idnEnsureBuffer(IDNCONTEXT *ctx, unsigned minLen)
+{
+    // Check for buffer enlargement
+    if(ctx->bufferLen < minLen)
+    {
+        if(ctx->bufferLen == 0) ctx->bufferLen = minLen;
+        else while(ctx->bufferLen < minLen) ctx->bufferLen *= 2;
+
+        ctx->bufferPtr = (uint8_t *)realloc(ctx->bufferPtr, ctx->bufferLen);
+    }
+
+    // Check buffer pointer
+    if(ctx->bufferPtr == (uint8_t *)0) 
+    { 
+        idnLogError("[IDN] Insufficient buffer memory"); 
+        ctx->payloadLen = 0;
+        return -1; 
+    }
+
+    return 0;
+}
+
+
+int idnShowAppend(SHOW *show, uint8_t *bufferPtr, unsigned dataOffset, unsigned dataEnd)
+{
+    if(show->frameCnt == show->frameCap)
+    {
+        unsigned frameCap = show->frameCap ? 2 * show->frameCap : 64;
+        SHOW_FRAME *frames = (SHOW_FRAME *)realloc(show->frames, frameCap * sizeof(SHOW_FRAME));
+        if(!frames) { idnLogError("[IDN] Insufficient show memory"); return -1; }
+
+        show->frames = frames;
+        show->frameCap = frameCap;
+    }
+
+    // Note: Shrinking never fails in practice, keep the original buffer otherwise
+    uint8_t *trimmedPtr = (uint8_t *)realloc(bufferPtr, dataEnd);
+    if(trimmedPtr) bufferPtr = trimmedPtr;
+
+    SHOW_FRAME *frame = &show->frames[show->frameCnt++];
+    frame->bufferPtr = bufferPtr;
+    frame->dataOffset = dataOffset;
+    frame->dataLen = dataEnd - dataOffset;
+
+    return 0;
+}
+
+
+void idnShowFree(SHOW *show)
+{
+    for(unsigned i = 0; i < show->frameCnt; i++) free(show->frames[i].bufferPtr);
+    if(show->frames) free(show->frames);
+
+    memset(show, 0, sizeof(SHOW));
+}
+
+
+static char int2Hex(unsigned i)
+{
+    i &= 0xf;
+    return (char)((i > 9) ? ((i - 10) + 'A') : (i + '0'));
+}
+
+
+static void binDump(void *buffer, unsigned length)
+{
+    if(!length || !buffer) return;
+
+    char send[80];
+    char *dst1 = 0, *dst2 = 0;
+    char *src = (char *)buffer;
+    unsigned k = 0;
+
+    printf("dump buffer %08X; %d Bytes\n", (uint32_t)(uintptr_t)buffer, length);
+
+    while(k < length)
+    {
+        if(!dst1)
+        {
+            memset(send, ' ', 80);
+            send[79] = 0;
+
+            send[0] = int2Hex((k >> 12) & 0x0f);
+            send[1] = int2Hex((k >> 8) & 0x0f);
+            send[2] = int2Hex((k >> 4) & 0x0f);
+            send[3] = int2Hex(k & 0x0f);
+            dst1 = &send[5];
+            dst2 = &send[57];
+        }
+
+        unsigned char c = *src++;
+        *dst1++ = int2Hex(c >> 4);
+        *dst1++ = int2Hex(c);
+        *dst1++ = ' ';
+        if((k % 16) == 7)
+        {*dst1++ = ' '; *dst1++ = ' ';}
+        if(c < 0x20) c = '.';
+        if(c > 0x7F) c = '.';
+        *dst2++ = c;
+
+        if((k % 16) == 15)
+        {
+            *dst2++ = 0;
+            printf("%s\n", send);
+            dst1 = 0;
+            dst2 = 0;
+        }
+        k++;
+    }
+
+    if(k % 16) printf("%s\n", send);
+
+    fflush(stdout);
+}
+
+
+static uint32_t idnTimestamp(uint64_t monoTimeNS)
+{
+    // IDN timestamps are 32 bit microseconds (wrap around), derived from the monotonic time line
+    return (uint32_t)(monoTimeNS / 1000);
+}
+
+
+static void txTimeSetLaunch(IDNCONTEXT *ctx, uint64_t launchTime)
+{
+    if(ctx->txTimeClock < 0) return;
+
+    // The etf qdisc drops datagrams with a launch time in the past - always keep some distance
+    uint64_t now = plt_getMonoTimeNS();
+    uint64_t minLaunchTime = now;
+    if(ctx->txTimeClock == PLT_CLOCK_TAI) minLaunchTime += (uint64_t)ctx->txLeadTime * 1000;
+    if(launchTime < minLaunchTime) launchTime = minLaunchTime;
+
+    // Map from the monotonic time line to the qdisc clock (and realtime for verification)
+    int64_t nsDelay = (int64_t)(launchTime - now);
+    ctx->txLaunchTime = plt_getClockNS(ctx->txTimeClock) + nsDelay;
+    ctx->txLaunchTimeRT = plt_getClockNS(PLT_CLOCK_REALTIME) + nsDelay;
+}
+
+
+static void txTimeFallback(IDNCONTEXT *ctx, const char *reason)
+{
+    idnLogError("[IDN] Kernel pacing disabled: %s. Using user-space pacing.", reason);
+
+    plt_sockDisableTxTimestamps(ctx->fdSocket);
+    ctx->txTimeClock = -1;
+    ctx->txProbeFrames = 0;
+}
+
+
+static void txTimeVerify(IDNCONTEXT *ctx)
+{
+    if(ctx->txTimeClock < 0) return;
+
+    // Drain the socket error queue (transmit timestamps and launch time errors)
+    unsigned dropCnt = 0, earlyCnt = 0;
+    while(1)
+    {
+        uint32_t datagramID = 0;
+        int64_t tsNS = 0;
+        int rc = plt_sockReadTxReport(ctx->fdSocket, &datagramID, &tsNS);
+        if(rc <= 0) break;
+
+        if(rc == 2) dropCnt++;
+        else if((rc == 1) && (tsNS != 0) && ctx->txProbeFrames)
+        {
+            // Datagram left (well) before its launch time: The qdisc does not honor launch times
+            int64_t early = ctx->txProbeLaunch[datagramID % TXTIME_PROBE_SLOTS] - tsNS;
+            if(early > ((int64_t)ctx->txLeadTime * 500)) earlyCnt++;
+            else ctx->txProbeOK++;
+        }
+    }
+
+    if(dropCnt) { txTimeFallback(ctx, "datagrams dropped by the qdisc (check clock and delta)"); return; }
+    if(earlyCnt) { txTimeFallback(ctx, "launch times not honored (no fq/etf qdisc configured)"); return; }
+
+    // Probe phase complete - stop transmit timestamps but keep on watching for errors
+    if(ctx->txProbeFrames && (--ctx->txProbeFrames == 0))
+    {
+        if(ctx->txProbeOK == 0) { txTimeFallback(ctx, "launch times cannot be verified"); return; }
+
+        idnLogInfo("[IDN] Kernel pacing verified (%u datagrams released on time)", ctx->txProbeOK);
+        plt_sockDisableTxTimestamps(ctx->fdSocket);
+    }
+}
+
+
+static int idnSend(void *context, IDNHDR_PACKET *packetHdr, unsigned packetLen)
+{
+    IDNCONTEXT *ctx = (IDNCONTEXT *)context;
+
+/*
+    printf("\n%u\n", (unsigned)((plt_getMonoTimeNS() - ctx->startTime) / 1000000));
+    binDump(packetHdr, packetLen);
+*/
+
+    if(ctx->shapeFlag)
+    {
+        // Traffic shaping: Hold the datagram back until the target and link budgets allow it
+        uint64_t now = plt_getMonoTimeNS();
+        uint64_t nsWait = shpReserve(&ctx->shaper, packetLen + IPUDP_HEADER_LEN, now);
+        if(nsWait && (ctx->txTimeClock >= 0))
+        {
+            // Kernel pacing: Postpone the launch time instead
+            int64_t launchTime = plt_getClockNS(ctx->txTimeClock) + (int64_t)nsWait;
+            if(launchTime > ctx->txLaunchTime)
+            {
+                ctx->txLaunchTimeRT += launchTime - ctx->txLaunchTime;
+                ctx->txLaunchTime = launchTime;
+            }
+        }
+        else if(nsWait && ctx->loopFlag)
+        {
+            // Event loop: No sleeping (other sessions). The next frame waits until the debt is paid.
+            if(now + nsWait > ctx->shapeUntil) ctx->shapeUntil = now + nsWait;
+        }
+        else if(nsWait)
+        {
+            plt_sleepUntilNS(now + nsWait);
+        }
+    }
+
+    ctx->datagramCnt++;
+    ctx->byteCnt += packetLen;
+    ctx->lastTxTime = plt_getMonoTimeNS();
+
+    if(ctx->txRing)
+    {
+        // Asynchronous send: Copy to a registered buffer, submitted once per frame
+        return txuQueue(ctx->txRing, packetHdr, packetLen);
+    }
+
+    if(ctx->txTimeClock >= 0)
+    {
+        // Kernel pacing: The qdisc releases the datagram at the launch time
+        ctx->txProbeLaunch[ctx->txDatagramCnt % TXTIME_PROBE_SLOTS] = ctx->txLaunchTimeRT;
+        ctx->txDatagramCnt++;
+
+        if(plt_sockSendToAt(ctx->fdSocket, packetHdr, packetLen, (struct sockaddr *)&ctx->serverSockAddr, sizeof(ctx->serverSockAddr), ctx->txLaunchTime) < 0)
+        {
+            idnLogError("sendmsg() failed (error: %d)", plt_sockGetLastError());
+            return -1;
+        }
+
+        return 0;
+    }
+
+    if(sendto(ctx->fdSocket, (const char *)packetHdr, packetLen, 0, (struct sockaddr *)&ctx->serverSockAddr, sizeof(ctx->serverSockAddr)) < 0)
+    {
+        idnLogError("sendto() failed (error: %d)", plt_sockGetLastError());
+        return -1;
+    }
+
+    return 0;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  Sender
+// -------------------------------------------------------------------------------------------------
+
+static uint16_t idnNextSequence(IDNCONTEXT *ctx)
+{
+    // Note: One sequence per IDN-Hello session, channels of a shared session count on together
+    if(ctx->connection) return ctx->connection->sequence++;
+    return ctx->sequence++;
+}
+
+
+static uint16_t idnChannelID(IDNCONTEXT *ctx)
+{
+    return ((uint16_t)ctx->channelID << 8) & IDNMSK_CONTENTID_CHANNELID;
+}
+
+
+static IDNHDR_CHANNEL_MESSAGE *idnPrependHeaders(IDNCONTEXT *ctx, uint8_t *chunkPtr, uint64_t now, uint16_t *contentIDPtr)
+{
+    // Prepend the headers, written backward from the sample chunk into the headroom
+    uint8_t *hdrPtr = chunkPtr;
+    uint16_t contentID = IDNFLG_CONTENTID_CHANNELMSG | idnChannelID(ctx);
+
+    // Insert channel config header every 200 ms
+    if((ctx->cfgTimestamp == 0) || ((now - ctx->cfgTimestamp) > 200000000ull))
+    {
+        // Standard IDTF-to-IDN descriptors
+        uint16_t *descriptors = (uint16_t *)(hdrPtr - (8 * sizeof(uint16_t)));
+        descriptors[0] = htons(0x4200);     // X
+        descriptors[1] = htons(0x4010);     // 16 bit precision
+        descriptors[2] = htons(0x4210);     // Y
+        descriptors[3] = htons(0x4010);     // 16 bit precision
+        descriptors[4] = htons(0x527E);     // Red, 638 nm
+        descriptors[5] = htons(0x5214);     // Green, 532 nm
+        descriptors[6] = htons(0x51CC);     // Blue, 460 nm
+        descriptors[7] = htons(0x0000);     // Void for alignment
+
+        // IDN-Stream channel configuration header
+        IDNHDR_CHANNEL_CONFIG *channelConfigHdr = (IDNHDR_CHANNEL_CONFIG *)descriptors - 1;
+        channelConfigHdr->wordCount = 4;
+        channelConfigHdr->flags = IDNFLG_CHNCFG_ROUTING;
+        channelConfigHdr->serviceID = ctx->serviceID;
+        channelConfigHdr->serviceMode = ctx->serviceMode;
+
+        // Move header start and set flag in contentID field
+        hdrPtr = (uint8_t *)channelConfigHdr;
+        contentID |= IDNFLG_CONTENTID_CONFIG_LSTFRG;
+        ctx->cfgTimestamp = now;
+    }
+
+    // IDN-Stream channel message header and IDN-Hello packet header
+    IDNHDR_CHANNEL_MESSAGE *channelMsgHdr = (IDNHDR_CHANNEL_MESSAGE *)hdrPtr - 1;
+    IDNHDR_PACKET *packetHdr = (IDNHDR_PACKET *)channelMsgHdr - 1;
+    packetHdr->command = IDNCMD_RT_CNLMSG;
+    packetHdr->flags = ctx->clientGroup;
+
+    *contentIDPtr = contentID;
+    return channelMsgHdr;
+}
+
+
+static void idnAckRequest(IDNCONTEXT *ctx, IDNHDR_PACKET *packetHdr, uint64_t now)
+{
+    // Request an acknowledge once per interval with a channel message (sequence already set).
+    // Note: One request outstanding, unanswered until the next one is due counts as lost.
+    if(!ctx->ackIntervalNS) return;
+    if(ctx->ackSendTime && (now - ctx->ackSendTime < ctx->ackIntervalNS)) return;
+    if(ctx->ackPending) ctx->ackLostCnt++;
+
+    packetHdr->command = IDNCMD_RT_CNLMSG_ACKREQ;
+    ctx->ackSequence = ntohs(packetHdr->sequence);
+    ctx->ackSendTime = now;
+    ctx->ackPending = 1;
+    ctx->ackReqCnt++;
+}
+
+
+static const char *idnAckResultText(uint8_t resultCode)
+{
+    if(resultCode == IDNVAL_RTACK_ERR_NOT_CONNECTED) return "not connected";
+    if(resultCode == IDNVAL_RTACK_ERR_OCCUPIED) return "all sessions occupied";
+    if(resultCode == IDNVAL_RTACK_ERR_EXCLUDED) return "client group excluded";
+    if(resultCode == IDNVAL_RTACK_ERR_PAYLOAD) return "invalid payload";
+    if(resultCode == IDNVAL_RTACK_ERR_GENERIC) return "processing error";
+    return "error";
+}
+
+
+static void idnAckWait(IDNCONTEXT *ctx, uint64_t until)
+{
+    // Sleep on the socket while an acknowledge is outstanding (taken as soon as it arrives). Note:
+    // Wakes up for the keepalive, the caller sleeps the remaining time. Virtual time: Poll only.
+    if(!ctx->ackPollFlag) return;
+    if(plt_isVirtualClock()) { idnPollAck(ctx); return; }
+    if(ctx->keepaliveNS && ctx->lastTxTime && (ctx->lastTxTime + ctx->keepaliveNS < until)) until = ctx->lastTxTime + ctx->keepaliveNS;
+
+    while(ctx->ackPending && plt_sockWaitRecvUntilNS(ctx->fdSocket, until))
+    {
+        unsigned ackCnt = ctx->ackCnt;
+        idnPollAck(ctx);
+        if(ctx->ackCnt == ackCnt) break;
+    }
+}
+
+
+int idnReceiveAck(IDNCONTEXT *ctx, const uint8_t *buffer, unsigned length, uint64_t now)
+{
+    // Acknowledge of the outstanding request? Note: Late ones (counted lost) are ignored.
+    if(length < sizeof(IDNHDR_PACKET) + sizeof(IDNHDR_RT_ACKNOWLEDGE)) return 0;
+    const IDNHDR_PACKET *packetHdr = (const IDNHDR_PACKET *)buffer;
+    const IDNHDR_RT_ACKNOWLEDGE *ackHdr = (const IDNHDR_RT_ACKNOWLEDGE *)&packetHdr[1];
+    if(packetHdr->command != IDNCMD_RT_ACKNOWLEDGE) return 0;
+    if(!ctx->ackPending || (ntohs(packetHdr->sequence) != ctx->ackSequence)) return 0;
+    if(ackHdr->structSize < sizeof(IDNHDR_RT_ACKNOWLEDGE)) return 0;
+
+    // Round-trip time
+    uint32_t rtt = (uint32_t)((now - ctx->ackSendTime) / 1000);
+    ctx->ackPending = 0;
+    if(!ctx->ackCnt || (rtt < ctx->ackRttMin)) ctx->ackRttMin = rtt;
+    if(rtt > ctx->ackRttMax) ctx->ackRttMax = rtt;
+    ctx->ackRttSum += rtt;
+    ctx->ackCnt++;
+
+    // Events since the previous acknowledge (new connection, sequence errors seen by the server)
+    uint16_t events = ntohs(ackHdr->eventFlags);
+    ctx->ackEvents |= events;
+    if(events & IDNMSK_RTACK_EVFLG_SEQERR) ctx->ackSeqErrCnt++;
+
+    // Result. Note: Logged on change only (a rejected stream is acknowledged once per interval)
+    uint8_t resultCode = (uint8_t)ackHdr->resultCode;
+    if(ackHdr->resultCode < 0) ctx->ackErrorCnt++;
+    if((resultCode != ctx->ackResult) && (ackHdr->resultCode < 0))
+    {
+        idnLogError("[IDN] %s: Stream rejected by the server: %s (0x%02X)", inet_ntoa(ctx->serverSockAddr.sin_addr),
+                    idnAckResultText(resultCode), resultCode);
+    }
+    else if((resultCode != ctx->ackResult) && (ctx->ackResult != IDNVAL_RTACK_SUCCESS))
+    {
+        idnLogInfo("[IDN] %s: Stream accepted by the server", inet_ntoa(ctx->serverSockAddr.sin_addr));
+    }
+    ctx->ackResult = resultCode;
+
+    return 1;
+}
+
+
+void idnPollAck(IDNCONTEXT *ctx)
+{
+    // Take the datagrams waiting on the socket (never blocks), others than the server's are dropped
+    uint8_t buffer[64];
+    struct sockaddr_in fromAddr;
+    int length;
+    while((length = plt_sockRecvFromNow(ctx->fdSocket, buffer, sizeof(buffer), &fromAddr)) > 0)
+    {
+        if(fromAddr.sin_addr.s_addr != ctx->serverSockAddr.sin_addr.s_addr) continue;
+        idnReceiveAck(ctx, buffer, (unsigned)length, plt_getMonoTimeNS());
+    }
+}
+
+
+void idnReportAck(IDNCONTEXT *ctx, const char *prefix)
+{
+    if(!ctx->ackReqCnt) return;
+
+    idnLogInfo("%s Acknowledge: %u of %u answered, %u lost, round trip min %u us, avg %u us, max %u us, "
+               "%u errors, %u sequence errors reported, events 0x%04X", prefix, ctx->ackCnt, ctx->ackReqCnt,
+               ctx->ackLostCnt, ctx->ackRttMin, ctx->ackCnt ? (unsigned)(ctx->ackRttSum / ctx->ackCnt) : 0,
+               ctx->ackRttMax, ctx->ackErrorCnt, ctx->ackSeqErrCnt, ctx->ackEvents);
+}
+
+
+int idnSendVoid(IDNCONTEXT *ctx)
+{
+    // Note: Own buffer, the work buffer may be in use by the decoder thread
+    uint8_t buffer[sizeof(IDNHDR_PACKET) + sizeof(IDNHDR_CHANNEL_MESSAGE)];
+
+    // IDN-Hello packet header
+    IDNHDR_PACKET *packetHdr = (IDNHDR_PACKET *)buffer;
+    packetHdr->command = IDNCMD_RT_CNLMSG;
+    packetHdr->flags = ctx->clientGroup;
+    packetHdr->sequence = htons(idnNextSequence(ctx));
+
+    // IDN-Stream channel message header
+    IDNHDR_CHANNEL_MESSAGE *channelMsgHdr = (IDNHDR_CHANNEL_MESSAGE *)&packetHdr[1];
+    uint16_t contentID = IDNFLG_CONTENTID_CHANNELMSG | idnChannelID(ctx) | IDNVAL_CNKTYPE_VOID;
+    channelMsgHdr->contentID = htons(contentID);
+
+    // Pointer to the end of the buffer for message length and packet length calculation
+    uint8_t *payloadLimit = (uint8_t *)&channelMsgHdr[1];
+
+    // Populate message header fields
+    uint64_t now = plt_getMonoTimeNS();
+    channelMsgHdr->totalSize = htons((unsigned short)(payloadLimit - (uint8_t *)channelMsgHdr));
+    channelMsgHdr->timestamp = htonl(idnTimestamp(now));
+
+    // Send the packet
+    idnAckRequest(ctx, packetHdr, now);
+    ctx->voidCnt++;
+    txTimeSetLaunch(ctx, now);
+    if(idnSend(ctx, packetHdr, payloadLimit - (uint8_t *)packetHdr)) return -1;
+    if(ctx->txRing && txuSubmit(ctx->txRing)) return -1;
+
+    return 0;
+}
+
+
+int idnKeepalive(IDNCONTEXT *ctx, uint64_t until)
+{
+    // Sleep towards the given time. Whenever the channel would be quiet for longer than the
+    // keepalive interval meanwhile, wake up once and send a void message. Note: Nothing to keep
+    // alive before the first datagram. The caller waits for the remaining time.
+    if(!ctx->keepaliveNS || !ctx->lastTxTime) return 0;
+
+    uint64_t due;
+    while((due = ctx->lastTxTime + ctx->keepaliveNS) < until)
+    {
+        idnAckWait(ctx, due);
+        plt_sleepUntilNS(due);
+        if(idnSendVoid(ctx)) return -1;
+    }
+
+    return 0;
+}
+
+
+uint64_t idnFrameDeadline(IDNCONTEXT *ctx)
+{
+    // Deadline of the next frame in the schedule
+    return ctx->scheduleStart + (((uint64_t)ctx->scheduleIndex * 1000000000ull) / ctx->frameRate);
+}
+
+
+int idnWaitDeadline(IDNCONTEXT *ctx, uint64_t *deadlinePtr)
+{
+    // Pace frames against an absolute schedule (frame k due at start + k * period), so that
+    // oversleeping does not accumulate. With kernel pacing, wake up ahead of time and leave the
+    // remaining wait to the qdisc (launch time attached to the frame datagrams). Driven by an event
+    // loop, the wait is not slept but returned (WAIT_DEADLINE_EARLY, schedule not advanced).
+    if(ctx->txRing) txuReap(ctx->txRing);
+    uint64_t now = plt_getMonoTimeNS();
+    if(ctx->scheduleIndex == 0) ctx->scheduleStart = ctx->timeline ? tmlGetEpoch(ctx->timeline) : now;
+
+    // Common timeline joined late: Continue with the next frame due (same frame indices as the others)
+    if((ctx->scheduleIndex == 0) && ctx->timeline) ctx->scheduleIndex = (uint32_t)tmlGetNextFrame(ctx->timeline, now);
+    uint64_t deadline = idnFrameDeadline(ctx);
+    uint64_t nsLead = (ctx->txTimeClock >= 0) ? (uint64_t)ctx->txLeadTime * 1000 : 0;
+    if(ctx->loopFlag)
+    {
+        // Event loop: Woken up ahead of the frame or held back by the shaper. Note: The caller
+        // keeps the channel alive meanwhile.
+        uint64_t wakeTime = deadline - nsLead;
+        if(ctx->shapeUntil > wakeTime) wakeTime = ctx->shapeUntil;
+        if(now < wakeTime) { *deadlinePtr = wakeTime; return WAIT_DEADLINE_EARLY; }
+    }
+    ctx->scheduleIndex++;
+
+    if(now > deadline + ((uint64_t)ctx->usFrameTime * 250))
+    {
+        // Missed the deadline (beyond jitter tolerance)
+        ctx->lateCnt++;
+        if(ctx->latePolicy == LATE_POLICY_SKIP)
+        {
+            // Drop the frame, the next one is (hopefully) on time
+            ctx->skipCnt++;
+            ctx->lastSendTime = 0;
+            return WAIT_DEADLINE_SKIP;
+        }
+        else if(ctx->latePolicy == LATE_POLICY_SEND)
+        {
+            // Send now and shift the remaining schedule
+            ctx->scheduleStart += now - deadline;
+            deadline = now;
+        }
+    }
+    else if(!ctx->loopFlag)
+    {
+        // Sleep until the deadline, optionally busy-wait the last part
+        idnAckWait(ctx, deadline - nsLead);
+        idnKeepalive(ctx, deadline - nsLead);
+        plt_waitUntilNS(deadline - nsLead, (uint64_t)ctx->spinTime * 1000);
+    }
+
+    *deadlinePtr = deadline;
+    return WAIT_DEADLINE_SEND;
+}
+
+
+int idnSendFrame(IDNCONTEXT *ctx, uint8_t *bufferPtr, unsigned chunkOffset, unsigned payloadEnd, uint64_t deadline)
+{
+    ctx->frameCnt++;
+
+    // Time on the wire. Note: With kernel pacing, the qdisc holds back the datagrams until the deadline
+    uint64_t now = plt_getMonoTimeNS();
+    if((ctx->txTimeClock >= 0) && (now < deadline)) now = deadline;
+
+    // Lateness statistics (deviation of the send time from the schedule), skew to the other targets
+    int32_t lateness = (int32_t)((now - deadline) / 1000);
+    if(ctx->timeline) tmlPutFrame(ctx->timeline, ctx->scheduleIndex - 1, (int64_t)(now - deadline));
+    ctx->latenessSum += lateness;
+    if(lateness > ctx->latenessMax) ctx->latenessMax = lateness;
+
+    // Inter-frame jitter (deviation of the interval between two frames from the frame period)
+    if(ctx->lastSendTime)
+    {
+        int64_t deviation = (int64_t)(now - ctx->lastSendTime) - (int64_t)(1000000000ull / ctx->frameRate);
+        int32_t jitter = (int32_t)(((deviation < 0) ? -deviation : deviation) / 1000);
+        ctx->jitterCnt++;
+        ctx->jitterSum += jitter;
+        if(jitter > ctx->jitterMax) ctx->jitterMax = jitter;
+    }
+    ctx->lastSendTime = now;
+
+    // ---------------------------------------------------------------------------------------------
+
+    // Prepend the headers
+    uint16_t contentID;
+    IDNHDR_CHANNEL_MESSAGE *channelMsgHdr = idnPrependHeaders(ctx, &bufferPtr[chunkOffset], now, &contentID);
+    IDNHDR_PACKET *packetHdr = (IDNHDR_PACKET *)channelMsgHdr - 1;
+
+    // IDN channel message header: Set timestamp (time on the wire, the deadline on a common timeline
+    // so that all targets get the same); Update internal timestamps.
+    uint32_t timestamp = idnTimestamp(ctx->timeline ? deadline : now);
+    txTimeSetLaunch(ctx, now);
+    channelMsgHdr->timestamp = htonl(timestamp);
+    ctx->frameTimestamp = now;
+
+    // Message header: Calculate message length. Must not exceed 0xFF00 octets !!
+    // Note: Pointer type uint8_t and substraction is defined as the difference of (array) elements.
+    uint8_t *payloadLimit = &bufferPtr[payloadEnd];
+    unsigned msgLength = payloadLimit - (uint8_t *)channelMsgHdr;
+    if(msgLength > MAX_IDN_MESSAGE_LEN)
+    {
+        // Fragmented frame (split across multiple messages), set message length and chunk type
+        channelMsgHdr->totalSize = htons(MAX_IDN_MESSAGE_LEN);
+        channelMsgHdr->contentID = htons(contentID | IDNVAL_CNKTYPE_LPGRF_FRAME_FIRST);
+        uint8_t *splitPtr = (uint8_t *)channelMsgHdr + MAX_IDN_MESSAGE_LEN;
+
+        // Set IDN-Hello sequence number (used on UDP for lost packet tracking)
+        packetHdr->sequence = htons(idnNextSequence(ctx));
+        idnAckRequest(ctx, packetHdr, now);
+
+        // Send the packet
+        if(idnSend(ctx, packetHdr, splitPtr - (uint8_t *)packetHdr)) return -1;
+
+        // Delete config flag (in case set - not config headers in fragments), set sequel fragment chunk type
+        contentID &= ~IDNFLG_CONTENTID_CONFIG_LSTFRG;
+        contentID |= IDNVAL_CNKTYPE_LPGRF_FRAME_SEQUEL;
+
+        // Send remaining fragments
+        while(1)
+        {
+            // Allocate message header (overwrite previous packet data), fragment number shared with timestamp
+            channelMsgHdr = (IDNHDR_CHANNEL_MESSAGE *)(splitPtr - sizeof(IDNHDR_CHANNEL_MESSAGE));
+            channelMsgHdr->timestamp = htonl(++timestamp);
+
+            // Allocate and populate packet header
+            packetHdr = (IDNHDR_PACKET *)((uint8_t *)channelMsgHdr - sizeof(IDNHDR_PACKET));
+            packetHdr->command = IDNCMD_RT_CNLMSG;
+            packetHdr->flags = ctx->clientGroup;
+            packetHdr->sequence = htons(idnNextSequence(ctx));
+
+            // Calculate remaining message length
+            msgLength = payloadLimit - (uint8_t *)channelMsgHdr;
+            if(msgLength > MAX_IDN_MESSAGE_LEN)
+            {
+                // Middle sequel fragment
+                channelMsgHdr->totalSize = htons(MAX_IDN_MESSAGE_LEN);
+                channelMsgHdr->contentID = htons(contentID);
+                splitPtr = (uint8_t *)channelMsgHdr + MAX_IDN_MESSAGE_LEN;
+
+                // Send the packet
+                if(idnSend(ctx, packetHdr, splitPtr - (uint8_t *)packetHdr)) return -1;
+            }
+            else
+            {
+                // Last sequel fragment, set last fragment flag
+                channelMsgHdr->totalSize = htons((unsigned short)msgLength);
+                channelMsgHdr->contentID = htons(contentID | IDNFLG_CONTENTID_CONFIG_LSTFRG);
+
+                // Send the packet
+                if(idnSend(ctx, packetHdr, payloadLimit - (uint8_t *)packetHdr)) return -1;
+
+                // Done sending the packet
+                break;
+            }
+        }
+    }
+    else
+    {
+        // Regular frame (single message), set message length and chunk type
+        channelMsgHdr->totalSize = htons((unsigned short)msgLength);
+        channelMsgHdr->contentID = htons(contentID | IDNVAL_CNKTYPE_LPGRF_FRAME);
+
+        // Set IDN-Hello sequence number (used on UDP for lost packet tracking)
+        packetHdr->sequence = htons(idnNextSequence(ctx));
+        idnAckRequest(ctx, packetHdr, now);
+
+        // Send the packet
+        if(idnSend(ctx, packetHdr, payloadLimit - (uint8_t *)packetHdr)) return -1;
+    }
+
+    // Submit the frame datagrams (asynchronous send engine), check kernel pacing reports
+    if(ctx->txRing && txuSubmit(ctx->txRing)) return -1;
+    txTimeVerify(ctx);
+
+    return 0;
+}
+
+
+int idnFlushWave(IDNCONTEXT *ctx)
+{
+    if(ctx->waveFill == 0) return 0;
+
+    // Continuous waveform: The chunk is due at the sample clock time of its first sample.
+    // Note: The sample clock starts with the first chunk.
+    if(ctx->txRing) txuReap(ctx->txRing);
+    uint64_t now = plt_getMonoTimeNS();
+    if(ctx->waveClock == 0) ctx->waveStart = now;
+    uint64_t deadline = ctx->waveStart + ((ctx->waveClock * 1000000000ull) / ctx->scanSpeed);
+    uint64_t nsChunkTime = ((uint64_t)ctx->waveFill * 1000000000ull) / ctx->scanSpeed;
+
+    if(now > deadline + nsChunkTime)
+    {
+        // Missed a whole chunk (the receiver ran dry), continue the sample clock from now
+        ctx->lateCnt++;
+        ctx->waveStart += now - deadline;
+        deadline = now;
+    }
+    else
+    {
+        // Sleep until the deadline, optionally busy-wait the last part
+        uint64_t nsLead = (ctx->txTimeClock >= 0) ? (uint64_t)ctx->txLeadTime * 1000 : 0;
+        idnAckWait(ctx, deadline - nsLead);
+        idnKeepalive(ctx, deadline - nsLead);
+        plt_waitUntilNS(deadline - nsLead, (uint64_t)ctx->spinTime * 1000);
+    }
+
+    // Time on the wire, lateness statistics
+    now = plt_getMonoTimeNS();
+    if((ctx->txTimeClock >= 0) && (now < deadline)) now = deadline;
+    int32_t lateness = (int32_t)((now - deadline) / 1000);
+    ctx->latenessSum += lateness;
+    if(lateness > ctx->latenessMax) ctx->latenessMax = lateness;
+
+    // Sample chunk header: Duration derived from the sample clock (no accumulated rounding)
+    uint64_t waveEnd = ctx->waveClock + ctx->waveFill;
+    uint32_t chunkDuration = (uint32_t)(((waveEnd * 1000000ull) / ctx->scanSpeed) - ((ctx->waveClock * 1000000ull) / ctx->scanSpeed));
+    IDNHDR_SAMPLE_CHUNK *sampleChunkHdr = (IDNHDR_SAMPLE_CHUNK *)&ctx->waveBufferPtr[FRAME_HEADROOM];
+    sampleChunkHdr->flagsDuration = htonl(chunkDuration);
+    uint8_t *payloadLimit = (uint8_t *)&sampleChunkHdr[1] + (ctx->waveFill * XYRGB_SAMPLE_SIZE);
+
+    // Prepend the headers. Note: Timestamp is the sample clock time (consistent with the durations)
+    uint16_t contentID;
+    IDNHDR_CHANNEL_MESSAGE *channelMsgHdr = idnPrependHeaders(ctx, (uint8_t *)sampleChunkHdr, now, &contentID);
+    IDNHDR_PACKET *packetHdr = (IDNHDR_PACKET *)channelMsgHdr - 1;
+    channelMsgHdr->totalSize = htons((unsigned short)(payloadLimit - (uint8_t *)channelMsgHdr));
+    channelMsgHdr->contentID = htons(contentID | IDNVAL_CNKTYPE_LPGRF_WAVE);
+    channelMsgHdr->timestamp = htonl(idnTimestamp(deadline));
+    packetHdr->sequence = htons(idnNextSequence(ctx));
+    idnAckRequest(ctx, packetHdr, now);
+
+    // Send the packet, check kernel pacing reports
+    txTimeSetLaunch(ctx, deadline);
+    if(idnSend(ctx, packetHdr, payloadLimit - (uint8_t *)packetHdr)) return -1;
+    if(ctx->txRing && txuSubmit(ctx->txRing)) return -1;
+    txTimeVerify(ctx);
+
+    ctx->waveClock = waveEnd;
+    ctx->waveFill = 0;
+    ctx->waveChunkCnt++;
+
+    return 0;
+}
+
+
+int idnSendWave(IDNCONTEXT *ctx, const uint8_t *samplePtr, unsigned sampleCnt)
+{
+    ctx->frameCnt++;
+
+    // Keep the first frame, single-frame files are held by scanning it repeatedly
+    if((ctx->frameCnt == 1) && !ctx->waveHoldPtr)
+    {
+        ctx->waveHoldPtr = (uint8_t *)malloc(sampleCnt * XYRGB_SAMPLE_SIZE);
+        if(ctx->waveHoldPtr) memcpy(ctx->waveHoldPtr, samplePtr, sampleCnt * XYRGB_SAMPLE_SIZE);
+        ctx->waveHoldCnt = ctx->waveHoldPtr ? sampleCnt : 0;
+    }
+
+    // Waveform length: Scan the frame once (jitter-free option), otherwise repeat the scan to fill
+    // the frame period (like a receiver in discrete mode does)
+    uint64_t waveLen = sampleCnt;
+    unsigned periodLen = ctx->scanSpeed / ctx->frameRate;
+    if(!ctx->jitterFreeFlag && (waveLen < periodLen)) waveLen = periodLen;
+
+    uint8_t *samplesBase = &ctx->waveBufferPtr[FRAME_HEADROOM + sizeof(IDNHDR_SAMPLE_CHUNK)];
+    unsigned scanPos = 0;
+    for(uint64_t i = 0; i < waveLen; i++)
+    {
+        const uint8_t *src = &samplePtr[scanPos * XYRGB_SAMPLE_SIZE];
+        uint8_t *dst = &samplesBase[ctx->waveFill * XYRGB_SAMPLE_SIZE];
+
+        // Galvo sample bytes
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = src[3];
+
+        // Color. Note: The first sample of a scan is the start point (invisible, move only)
+        uint8_t r = 0, g = 0, b = 0;
+        if(scanPos != 0) { r = src[4]; g = src[5]; b = src[6]; }
+
+        if(ctx->waveShift)
+        {
+            // Color lags the position by the color shift, continuous across scans and frames
+            uint8_t *line = &ctx->waveColorLine[ctx->waveColorPos * 3];
+            dst[4] = line[0];
+            dst[5] = line[1];
+            dst[6] = line[2];
+            line[0] = r;
+            line[1] = g;
+            line[2] = b;
+            if(++ctx->waveColorPos >= ctx->waveShift) ctx->waveColorPos = 0;
+        }
+        else
+        {
+            dst[4] = r;
+            dst[5] = g;
+            dst[6] = b;
+        }
+
+        if(++scanPos >= sampleCnt) scanPos = 0;
+
+        // Send the chunk when full
+        if((++ctx->waveFill >= ctx->waveChunkLen) && idnFlushWave(ctx)) return -1;
+    }
+
+    return 0;
+}
+
+
+static FRAME_QUEUE_SLOT *idnWaitFrame(IDNCONTEXT *ctx)
+{
+    // Wait for the decoder. While it stalls, keep the channel alive (one wakeup per interval).
+    while(1)
+    {
+        uint64_t due = (ctx->keepaliveNS && ctx->lastTxTime) ? ctx->lastTxTime + ctx->keepaliveNS : 0;
+
+        int timeoutFlag;
+        FRAME_QUEUE_SLOT *slot = frqGetBeginUntil(ctx->frameQueue, due, &timeoutFlag);
+        if(!timeoutFlag) return slot;
+
+        if(idnSendVoid(ctx)) return (FRAME_QUEUE_SLOT *)0;
+    }
+}
+
+
+int idnRunSender(IDNCONTEXT *ctx)
+{
+    // Send the frames decoded ahead, until the decoder closes the queue. Note: The first frame
+    // starts the schedule, all later frames are taken at their deadline (the decoder can use all
+    // slots meanwhile and an empty queue at that point is an underrun).
+    FRAME_QUEUE_SLOT *slot = idnWaitFrame(ctx);
+    while(1)
+    {
+        // Note: In wave mode, the chunks are paced by the sample clock
+        uint64_t deadline = 0;
+        int skipFlag = ctx->waveChunkLen ? 0 : idnWaitDeadline(ctx, &deadline);
+
+        if(!slot) slot = idnWaitFrame(ctx);
+        if(!slot) break;
+
+        int rc = 0;
+        if(ctx->waveChunkLen)
+        {
+            unsigned sampleOffset = slot->dataOffset + sizeof(IDNHDR_SAMPLE_CHUNK);
+            unsigned sampleCnt = (slot->dataLen - sizeof(IDNHDR_SAMPLE_CHUNK)) / XYRGB_SAMPLE_SIZE;
+            rc = idnSendWave(ctx, &slot->bufferPtr[sampleOffset], sampleCnt);
+        }
+        else if(!skipFlag)
+        {
+            rc = idnSendFrame(ctx, slot->bufferPtr, slot->dataOffset, slot->dataOffset + slot->dataLen, deadline);
+        }
+        frqGetEnd(ctx->frameQueue);
+        slot = (FRAME_QUEUE_SLOT *)0;
+
+        // Send error: Stop the decoder as well
+        if(rc) { frqAbort(ctx->frameQueue); return -1; }
+    }
+
+    return 0;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  IDN
+// -------------------------------------------------------------------------------------------------
+
+int idnOpenFrameXYRGB(void *context)
+{
+    IDNCONTEXT *ctx = (IDNCONTEXT *)context;
+
+    // Sanity check (buffer already in use?)
+    if(ctx->payloadLen != 0) return -1;
+
+    // Make sure there is enough buffer
+    if(idnEnsureBuffer(ctx, 0x4000)) return -1;
+
+    // Note: IDN-Hello packet header, IDN-Stream channel message header and channel configuration
+    // are prepended on send (into the headroom), the sender decides on the configuration.
+
+    // Setup for sample chunk data positions
+    ctx->sampleChunkHdrOffset = FRAME_HEADROOM;
+    ctx->payloadLen = FRAME_HEADROOM + sizeof(IDNHDR_SAMPLE_CHUNK);
+    ctx->sampleCnt = 0;
+
+    return 0;
+}
+
+
+int idnPutSampleXYRGB(void *context, int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b)
+{
+    IDNCONTEXT *ctx = (IDNCONTEXT *)context;
+
+    // Sanity check (sample chunk bracket open?)
+    if(ctx->payloadLen == 0) return -1;
+
+    // Make sure there is enough buffer.
+    unsigned lenNeeded = ctx->payloadLen + ((1 + ctx->colorShift) * XYRGB_SAMPLE_SIZE);
+    if(idnEnsureBuffer(ctx, lenNeeded)) return -1;
+
+
+    // Note: With IDN, the first two points and the last two points of a frame have special 
+    // meanings, The first point is the start point and shall be invisible (not part of the frame, 
+    // not taken into account with duration calculations) and is used to move the draw cursor 
+    // only. This is because a shape of n points has n-1 connecting segments (with associated time
+    // and color). The shape is closed when last point and first point are equal and the shape is
+    // continuous when first segment and last segment are continuous. Hidden lines or bends shall 
+    // be inserted on the fly in case of differing start point and end point or discontinuity.
+
+
+    // Get pointer to next sample
+    uint8_t *p = &ctx->bufferPtr[ctx->payloadLen];
+
+    // Store galvo sample bytes
+    *p++ = (uint8_t)(x >> 8);
+    *p++ = (uint8_t)x;
+    *p++ = (uint8_t)(y >> 8);
+    *p++ = (uint8_t)y;
+
+    // Check for color shift init
+    if(ctx->sampleCnt == 0) 
+    {
+        // Color shift samples
+        for(unsigned i = 0; i < ctx->colorShift; i++) 
+        {
+            p[0] = 0;
+            p[1] = 0;
+            p[2] = 0;
+            p += XYRGB_SAMPLE_SIZE;
+        }
+    }
+    else
+    {
+        // Other samples - just move the pointer
+        p += XYRGB_SAMPLE_SIZE * ctx->colorShift;
+    }
+
+    // Store color sample bytes
+    *p++ = r;
+    *p++ = g;
+    *p++ = b;
+
+    // Update payload length to include the sample, update sample count
+    ctx->payloadLen += XYRGB_SAMPLE_SIZE;
+    ctx->sampleCnt++;
+
+    return 0;
+}
+
+
+static int idnProcessFrame(IDNCONTEXT *ctx)
+{
+    // Number of samples to exactly fill the frame period (frame duration is sampleCnt - 1 samples).
+    // Note: The color shift samples are appended after processing.
+    unsigned targetCnt = (ctx->scanSpeed / ctx->frameRate) + 1;
+    targetCnt = (targetCnt > ctx->processShift + 2) ? targetCnt - ctx->processShift : 2;
+
+    unsigned sampleOffset = ctx->sampleChunkHdrOffset + sizeof(IDNHDR_SAMPLE_CHUNK);
+    if(frmLoadXYRGB(&ctx->processSource, &ctx->bufferPtr[sampleOffset], ctx->sampleCnt))
+    {
+        idnLogError("[IDN] Insufficient frame memory (%u samples)", ctx->sampleCnt);
+        return -1;
+    }
+
+    FRAME_SOA *frame = &ctx->processSource;
+    if(ctx->resampleFlag)
+    {
+        // Retime the path to exactly fill the frame period
+        if(frmResample(&ctx->processTarget, frame, targetCnt))
+        {
+            idnLogError("[IDN] Resampling failed (%u samples)", ctx->sampleCnt);
+            return -1;
+        }
+        frame = &ctx->processTarget;
+    }
+    else if(ctx->budgetFlag && (frame->sampleCnt > targetCnt))
+    {
+        // Over budget: Reduce the path, keeping the color edges
+        int reducedCnt = frmDecimate(&ctx->processTarget, frame, targetCnt);
+        if(reducedCnt < 0)
+        {
+            idnLogError("[IDN] Point reduction failed (%u samples)", ctx->sampleCnt);
+            return -1;
+        }
+
+        // Note: Frames without removable samples (all color edges) do not count as reduced
+        unsigned removedCnt = frame->sampleCnt - (unsigned)reducedCnt;
+        if(removedCnt)
+        {
+            ctx->reduceCnt++;
+            ctx->reduceSum += removedCnt;
+            if(removedCnt > ctx->reduceMax) ctx->reduceMax = removedCnt;
+        }
+        if((unsigned)reducedCnt > targetCnt) ctx->overBudgetCnt++;
+        frame = &ctx->processTarget;
+    }
+
+    // Replace the frame samples
+    unsigned sampleCnt = frame->sampleCnt + ctx->processShift;
+    unsigned payloadLen = sampleOffset + (sampleCnt * XYRGB_SAMPLE_SIZE);
+    if(idnEnsureBuffer(ctx, payloadLen)) return -1;
+    frmStoreXYRGB(frame, &ctx->bufferPtr[sampleOffset], ctx->processShift);
+    ctx->payloadLen = payloadLen;
+    ctx->sampleCnt = sampleCnt;
+
+    return 0;
+}
+
+
+int idnFinishFrameXYRGB(IDNCONTEXT *ctx, unsigned *payloadEndPtr)
+{
+    // Sanity check (sample chunk bracket open?)
+    if(ctx->payloadLen == 0) return -1;
+    if(ctx->sampleCnt < 2) { idnLogError("[IDN] Invalid sample count %u", ctx->sampleCnt); return -1; }
+
+    // ---------------------------------------------------------------------------------------------
+
+    // Duplicate last position for color shift samples
+    for(unsigned i = 0; i < ctx->colorShift; i++) 
+    {
+        // Get pointer to last position and next sample (already has color due to shift)
+        uint16_t *src = (uint16_t *)&ctx->bufferPtr[ctx->payloadLen - XYRGB_SAMPLE_SIZE];
+        uint16_t *dst = (uint16_t *)&ctx->bufferPtr[ctx->payloadLen];
+
+        // Duplicate position samples (X/Y)
+        *dst++ = *src++;
+        *dst++ = *src++;
+
+        // Update pointer to next sample, update sample count
+        ctx->payloadLen += XYRGB_SAMPLE_SIZE;
+        ctx->sampleCnt++;
+    }
+
+    // Resample/reduce the frame to the frame period. Note: Color shift applied by the processing
+    if((ctx->resampleFlag || ctx->budgetFlag) && idnProcessFrame(ctx)) return -1;
+
+    // Sample chunk header: Calculate frame duration based on scan speed.
+    // In case jitter-free option is set: Scan frames (starting from second) ony once.
+    IDNHDR_SAMPLE_CHUNK *sampleChunkHdr = (IDNHDR_SAMPLE_CHUNK *)&ctx->bufferPtr[ctx->sampleChunkHdrOffset];
+    uint32_t frameDuration = (((uint64_t)(ctx->sampleCnt - 1)) * 1000000ull) / (uint64_t)ctx->scanSpeed;
+    uint8_t frameFlags = 0;
+    if(ctx->jitterFreeFlag && ctx->decodeCnt != 0) frameFlags |= IDNFLG_GRAPHIC_FRAME_ONCE;
+    sampleChunkHdr->flagsDuration = htonl((frameFlags << 24) | frameDuration);
+
+    ctx->decodeCnt++;
+    ctx->decodeSampleCnt += ctx->sampleCnt;
+
+    // Invalidate payload - cause error in case of invalid call order
+    *payloadEndPtr = ctx->payloadLen;
+    ctx->payloadLen = 0;
+
+    return 0;
+}
+
+
+void idnSwapFrameBuffer(IDNCONTEXT *ctx, FRAME_QUEUE_SLOT *slot, unsigned payloadEnd)
+{
+    // Hand the frame over to the sender thread (swap buffers with the queue slot)
+    uint8_t *bufferPtr = slot->bufferPtr;
+    unsigned bufferLen = slot->bufferLen;
+    slot->bufferPtr = ctx->bufferPtr;
+    slot->bufferLen = ctx->bufferLen;
+    slot->dataOffset = ctx->sampleChunkHdrOffset;
+    slot->dataLen = payloadEnd - ctx->sampleChunkHdrOffset;
+    ctx->bufferPtr = bufferPtr;
+    ctx->bufferLen = bufferLen;
+}
+
+
+static int idnQueueFrame(IDNCONTEXT *ctx, unsigned payloadEnd)
+{
+    if(ctx->frameQueue)
+    {
+        // Note: Waits for a free slot (decoder runs ahead at most the queue depth)
+        FRAME_QUEUE_SLOT *slot = frqPutBegin(ctx->frameQueue);
+        if(!slot) return -1;
+
+        idnSwapFrameBuffer(ctx, slot, payloadEnd);
+        frqPutEnd(ctx->frameQueue);
+        return 0;
+    }
+
+    // Send inline (no lookahead)
+    if(ctx->waveChunkLen)
+    {
+        return idnSendWave(ctx, &ctx->bufferPtr[ctx->sampleChunkHdrOffset + sizeof(IDNHDR_SAMPLE_CHUNK)], ctx->sampleCnt);
+    }
+
+    uint64_t deadline = 0;
+    if(idnWaitDeadline(ctx, &deadline)) return 0;
+    return idnSendFrame(ctx, ctx->bufferPtr, ctx->sampleChunkHdrOffset, payloadEnd, deadline);
+}
+
+
+int idnPushFrameXYRGB(void *context)
+{
+    IDNCONTEXT *ctx = (IDNCONTEXT *)context;
+
+    unsigned payloadEnd = 0;
+    if(idnFinishFrameXYRGB(ctx, &payloadEnd)) return -1;
+
+    if(ctx->show)
+    {
+        // Preload: Keep the frame (hand over the buffer, trimmed to the frame)
+        if(idnShowAppend(ctx->show, ctx->bufferPtr, ctx->sampleChunkHdrOffset, payloadEnd)) return -1;
+        ctx->bufferPtr = (uint8_t *)0;
+        ctx->bufferLen = 0;
+        return 0;
+    }
+
+    if(ctx->holdFrameFlag)
+    {
+        // Keep a copy to repeat (the buffer is handed over, fragmentation overwrites the samples)
+        unsigned chunkLen = payloadEnd - ctx->sampleChunkHdrOffset;
+        uint8_t *holdPtr = (uint8_t *)realloc(ctx->holdFramePtr, chunkLen);
+        if(!holdPtr) { idnLogError("[IDN] Insufficient memory to hold the frame"); return -1; }
+
+        memcpy(holdPtr, &ctx->bufferPtr[ctx->sampleChunkHdrOffset], chunkLen);
+        ctx->holdFramePtr = holdPtr;
+        ctx->holdFrameLen = chunkLen;
+        ctx->holdFrameFlag = 0;
+    }
+
+    return idnQueueFrame(ctx, payloadEnd);
+}
+
+
+int idnRepeatFrame(IDNCONTEXT *ctx, unsigned repeatCnt)
+{
+    // Sanity check (frame kept?)
+    if(!ctx->holdFramePtr) return -1;
+
+    // Queue/send the kept frame again (no decoding). Note: Repeated frames are never the first one.
+    unsigned payloadEnd = ctx->sampleChunkHdrOffset + ctx->holdFrameLen;
+    for(unsigned i = 0; i < repeatCnt; i++)
+    {
+        if(idnEnsureBuffer(ctx, payloadEnd)) return -1;
+        memcpy(&ctx->bufferPtr[ctx->sampleChunkHdrOffset], ctx->holdFramePtr, ctx->holdFrameLen);
+        ctx->sampleCnt = (ctx->holdFrameLen - sizeof(IDNHDR_SAMPLE_CHUNK)) / XYRGB_SAMPLE_SIZE;
+
+        IDNHDR_SAMPLE_CHUNK *sampleChunkHdr = (IDNHDR_SAMPLE_CHUNK *)&ctx->bufferPtr[ctx->sampleChunkHdrOffset];
+        if(ctx->jitterFreeFlag) sampleChunkHdr->flagsDuration |= htonl(IDNFLG_GRAPHIC_FRAME_ONCE << 24);
+
+        if(idnQueueFrame(ctx, payloadEnd)) return -1;
+    }
+
+    return 0;
+}
+
+
+int idnSendChannelClose(IDNCONTEXT *ctx)
+{
+    // Sanity check (buffer already in use?)
+    if(ctx->payloadLen != 0) return -1;
+
+    // Make sure there is enough buffer
+    if(idnEnsureBuffer(ctx, 0x1000)) return -1;
+
+    // Close the channel: IDN-Hello packet header
+    IDNHDR_PACKET *packetHdr = (IDNHDR_PACKET *)ctx->bufferPtr;
+    packetHdr->command = IDNCMD_RT_CNLMSG;
+    packetHdr->flags = ctx->clientGroup;
+    packetHdr->sequence = htons(idnNextSequence(ctx));
+
+    // IDN-Stream channel message header
+    IDNHDR_CHANNEL_MESSAGE *channelMsgHdr = (IDNHDR_CHANNEL_MESSAGE *)&packetHdr[1];
+    uint16_t contentID = IDNFLG_CONTENTID_CHANNELMSG | idnChannelID(ctx) | IDNFLG_CONTENTID_CONFIG_LSTFRG | IDNVAL_CNKTYPE_VOID;
+    channelMsgHdr->contentID = htons(contentID);
+
+    // IDN-Stream channel config header (close channel)
+    IDNHDR_CHANNEL_CONFIG *channelConfigHdr = (IDNHDR_CHANNEL_CONFIG *)&channelMsgHdr[1];
+    channelConfigHdr->wordCount = 0;
+    channelConfigHdr->flags = IDNFLG_CHNCFG_CLOSE;
+    channelConfigHdr->serviceID = 0;
+    channelConfigHdr->serviceMode = 0;
+
+    // Pointer to the end of the buffer for message length and packet length calculation
+    uint8_t *payloadLimit = (uint8_t *)&channelConfigHdr[1];
+
+    // Populate message header fields
+    uint64_t now = plt_getMonoTimeNS();
+    channelMsgHdr->totalSize = htons((unsigned short)(payloadLimit - (uint8_t *)channelMsgHdr));
+    channelMsgHdr->timestamp = htonl(idnTimestamp(now));
+
+    // Send the packet. Note: The next frame opens the channel again (configuration included).
+    txTimeSetLaunch(ctx, now);
+    if(idnSend(ctx, packetHdr, payloadLimit - (uint8_t *)packetHdr)) return -1;
+    if(ctx->txRing && txuSubmit(ctx->txRing)) return -1;
+    ctx->cfgTimestamp = 0;
+
+    return 0;
+}
+
+
+int idnSendClose(void *context)
+{
+    IDNCONTEXT *ctx = (IDNCONTEXT *)context;
+
+    // Close the channel
+    if(idnSendChannelClose(ctx)) return -1;
+
+    // Other channels still running on the connection: Keep the session open
+    if(ctx->connection && ctx->connection->openCnt && --ctx->connection->openCnt) return 0;
+
+    // ---------------------------------------------------------------------------------------------
+
+    // Close the connection/session: IDN-Hello packet header
+    IDNHDR_PACKET *packetHdr = (IDNHDR_PACKET *)ctx->bufferPtr;
+    packetHdr->command = IDNCMD_RT_CNLMSG_CLOSE;
+    packetHdr->flags = ctx->clientGroup;
+    packetHdr->sequence = htons(idnNextSequence(ctx));
+
+    // Send the packet (gracefully close session)
+    if(idnSend(context, packetHdr, sizeof(IDNHDR_PACKET))) return -1;
+    if(ctx->txRing && txuSubmit(ctx->txRing)) return -1;
+
+    return 0;
+}
+
+
+int idnSendShowFrame(IDNCONTEXT *ctx, SHOW_FRAME *frame, uint64_t deadline)
+{
+    // Note: Fragmentation puts headers into the sample data. Send a copy of large frames.
+    if(frame->dataOffset + frame->dataLen <= MAX_IDN_MESSAGE_LEN)
+    {
+        return idnSendFrame(ctx, frame->bufferPtr, frame->dataOffset, frame->dataOffset + frame->dataLen, deadline);
+    }
+
+    unsigned payloadEnd = frame->dataOffset + frame->dataLen;
+    if(idnEnsureBuffer(ctx, payloadEnd)) return -1;
+    memcpy(&ctx->bufferPtr[frame->dataOffset], &frame->bufferPtr[frame->dataOffset], frame->dataLen);
+
+    return idnSendFrame(ctx, ctx->bufferPtr, frame->dataOffset, payloadEnd, deadline);
+}
@@ -0,0 +1,303 @@
+// -------------------------------------------------------------------------------------------------
+//  File idn-context.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created (stream context moved out of main.c)
+// -------------------------------------------------------------------------------------------------
+
+
+#ifndef IDN_CONTEXT_H
+#define IDN_CONTEXT_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// Platform includes
+#if defined(_WIN32) || defined(WIN32)
+
+    #include <windows.h>
+
+    #include "plt-windows.h"
+
+#else
+
+    #include <arpa/inet.h>
+
+    #include "plt-posix.h"
+
+#endif
+
+
+// Project headers
+#include "idn-hello.h"
+#include "idn-stream.h"
+#include "tx-uring.h"
+#include "shaper.h"
+#include "frame-queue.h"
+#include "frame.h"
+#include "timeline.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define DEFAULT_FRAMERATE               30
+#define DEFAULT_SCANSPEED               30000
+#define DEFAULT_KEEPALIVE               100         // Void message after this much silence (ms)
+
+#define MAX_IDN_MESSAGE_LEN             0xFF00      // IDN-Message maximum length (due to lower layer transport)
+//#define MAX_IDN_MESSAGE_LEN             0x0800      // Message len for fragmentation tests
+
+#define XYRGB_SAMPLE_SIZE               7
+
+#define DEFAULT_TXLEADTIME              1000        // Wake-up lead time for kernel pacing (us)
+#define TXTIME_PROBE_FRAMES             32          // Number of frames to verify the launch times
+#define TXTIME_PROBE_SLOTS              256         // Launch time history (by datagram ID)
+
+#define IPUDP_HEADER_LEN                28          // IPv4 + UDP header (shaped along with the payload)
+
+#define LATE_POLICY_SEND                0           // Late frame: Send, shift the schedule
+#define LATE_POLICY_SKIP                1           // Late frame: Drop, keep the schedule
+#define LATE_POLICY_CATCHUP             2           // Late frame: Send, keep the schedule
+
+#define WAIT_DEADLINE_SEND              0           // Frame due: Send it
+#define WAIT_DEADLINE_SKIP              1           // Frame late: Drop it (see latePolicy)
+#define WAIT_DEADLINE_EARLY             2           // Event loop: Not due yet, call again at the returned time
+
+// Room in front of the sample chunk for the headers (prepended by the sender)
+#define FRAME_HEADROOM                  (sizeof(IDNHDR_PACKET) + sizeof(IDNHDR_CHANNEL_MESSAGE) + \
+                                         sizeof(IDNHDR_CHANNEL_CONFIG) + (8 * sizeof(uint16_t)))
+
+#define IDN_LOG_ERROR                   0           // Log levels passed to the log function
+#define IDN_LOG_INFO                    1
+#define MAX_LOG_MESSAGE                 512         // Longer log messages are truncated
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+// Note: Called by any thread of the library, one complete line per call (no newline)
+typedef void (*IDN_LOG_FUNC)(void *context, int level, const char *message);
+
+typedef struct
+{
+    uint8_t *bufferPtr;                     // Frame buffer (headroom, sample chunk)
+    unsigned dataOffset;                    // Offset of the sample chunk
+    unsigned dataLen;                       // Length of the sample chunk
+
+} SHOW_FRAME;
+
+
+typedef struct
+{
+    SHOW_FRAME *frames;                     // Decoded frames, ready to send
+    unsigned frameCnt;                      // Number of frames
+    unsigned frameCap;                      // Capacity of the frame array
+
+} SHOW;
+
+
+typedef struct
+{
+    uint16_t sequence;                      // IDN-Hello sequence number, common to all channels
+    unsigned channelCnt;                    // Number of channels multiplexed
+    unsigned openCnt;                       // Number of channels not closed yet
+    uint64_t load;                          // Estimated send load of all channels (see SESSION_FRAME_COST)
+    unsigned shardIndex;                    // Shard (event loop, socket) of the channels + 1, 0: none
+
+} IDN_CONNECTION;
+
+
+typedef struct
+{
+    int fdSocket;                           // Socket file descriptor
+    struct sockaddr_in serverSockAddr;      // Target server address
+    unsigned char clientGroup;              // Client group to send on
+    unsigned char serviceID;                // ServiceID to use
+    unsigned char serviceMode;              // Service mode (discrete frames or continuous waveform)
+    unsigned frameRate;                     // Number of frames per second
+    unsigned usFrameTime;                   // Time for one frame in microseconds (1000000/frameRate)
+    int jitterFreeFlag;                     // Scan frames only once to exactly match frame rate
+    unsigned scanSpeed;                     // Scan speed in samples per second
+    unsigned colorShift;                    // Color shift in points/samples
+
+    unsigned bufferLen;                     // Length of work buffer
+    uint8_t *bufferPtr;                     // Pointer to work buffer
+
+    uint64_t startTime;                     // Monotonic time at stream start (log reference, ns)
+    uint32_t frameCnt;                      // Number of sent frames
+    uint64_t datagramCnt;                   // Number of sent datagrams
+    uint64_t byteCnt;                       // Number of sent bytes (IDN-Hello packets)
+    uint64_t frameTimestamp;                // Monotonic time of the last frame (ns)
+    uint64_t cfgTimestamp;                  // Monotonic time of the last channel configuration (ns)
+    uint64_t lastTxTime;                    // Monotonic time of the last datagram (ns), 0: none
+    uint64_t keepaliveNS;                   // Send a void message after this much silence (ns), 0: off
+    uint32_t voidCnt;                       // Number of void messages sent
+
+    // Buffer related
+    uint32_t payloadLen;                    // Currently used length of the buffer
+
+    // IDN-Hello related
+    uint16_t sequence;                      // IDN-Hello sequence number (UDP packet tracking)
+    IDN_CONNECTION *connection;             // IDN-Hello session shared with other channels, 0: own
+    uint8_t channelID;                      // IDN-Stream channel of the session (0..63)
+
+    // Acknowledge related
+    uint64_t ackIntervalNS;                 // Request an acknowledge this often (ns), 0: off
+    int ackPollFlag;                        // Poll the socket while waiting (own socket, no event loop)
+    int ackPending;                         // Acknowledge requested, not received yet
+    uint16_t ackSequence;                   // Sequence number of the request
+    uint64_t ackSendTime;                   // Monotonic time of the last request (ns), 0: none
+    uint32_t ackReqCnt;                     // Number of requests
+    uint32_t ackCnt;                        // Number of acknowledges received
+    uint32_t ackLostCnt;                    // Number of requests unanswered until the next one was due
+    uint64_t ackRttSum;                     // Sum of all round-trip times (microseconds)
+    uint32_t ackRttMin;                     // Minimum round-trip time (microseconds)
+    uint32_t ackRttMax;                     // Maximum round-trip time (microseconds)
+    uint8_t ackResult;                      // Result code of the last acknowledge (IDNVAL_RTACK_*)
+    uint32_t ackErrorCnt;                   // Number of acknowledges with an error result
+    uint16_t ackEvents;                     // Event flags of all acknowledges (IDNVAL_RTACK_EVFLG_*)
+    uint32_t ackSeqErrCnt;                  // Number of acknowledges reporting sequence errors
+
+    // IDN-Stream related
+    uint32_t sampleChunkHdrOffset;          // Offset of current sample chunk header 
+    uint32_t sampleCnt;                     // Current number of samples
+
+    // Kernel pacing (SO_TXTIME) related
+    int txTimeClock;                        // Clock of the launch times, -1: user-space pacing
+    unsigned txLeadTime;                    // Wake up this many microseconds ahead of the launch time
+    int64_t txLaunchTime;                   // Launch time of the current datagrams (txTimeClock)
+    int64_t txLaunchTimeRT;                 // Launch time of the current datagrams (realtime clock)
+    uint32_t txDatagramCnt;                 // Number of datagrams sent (transmit report ID)
+    unsigned txProbeFrames;                 // Number of frames left to verify the launch times
+    unsigned txProbeOK;                     // Number of datagrams that were released on time
+    int64_t txProbeLaunch[TXTIME_PROBE_SLOTS];  // Launch time (realtime clock) by datagram ID
+
+    // Frame pacing related
+    int latePolicy;                         // What to do with a frame that missed its deadline
+    unsigned spinTime;                      // Busy-wait this many microseconds before the deadline
+    int loopFlag;                           // Driven by an event loop: Waits returned to the caller, no sleeping
+    uint64_t scheduleStart;                 // Deadline of the first frame (schedule reference, ns)
+    TIMELINE *timeline;                     // Schedule common to several targets/processes, 0: own
+    uint32_t scheduleIndex;                 // Index of the next frame in the schedule
+    uint32_t lateCnt;                       // Number of frames that missed their deadline
+    uint32_t skipCnt;                       // Number of frames dropped because of lateness
+    int64_t latenessSum;                    // Sum of all send time deviations (microseconds)
+    int32_t latenessMax;                    // Maximum send time deviation (microseconds)
+    uint64_t lastSendTime;                  // Time on the wire of the previous frame (ns), 0: none
+    uint32_t jitterCnt;                     // Number of inter-frame intervals measured
+    int64_t jitterSum;                      // Sum of the interval deviations from the frame period (microseconds)
+    int32_t jitterMax;                      // Maximum interval deviation (microseconds)
+
+    // Transmit engine related
+    TXURING *txRing;                        // io_uring send engine, null: regular sendto()
+
+    // Traffic shaping related
+    int shapeFlag;                          // Datagrams pass the token bucket shaper
+    SHAPER_STREAM shaper;                   // Target bucket, attached to the link bucket
+    uint64_t shapeUntil;                    // Event loop: Shaper debt paid off, next frame held until then
+
+    // Frame processing related (decoder side)
+    int resampleFlag;                       // Retime frames to exactly fill the frame period
+    int budgetFlag;                         // Reduce frames to the samples of one frame period
+    unsigned processShift;                  // Color shift (applied after processing)
+    FRAME_SOA processSource;                // Decoded frame
+    FRAME_SOA processTarget;                // Resampled/reduced frame
+    uint32_t reduceCnt;                     // Number of frames reduced to the budget
+    uint32_t overBudgetCnt;                 // Number of frames still over budget (color edges)
+    uint64_t reduceSum;                     // Number of samples removed
+    unsigned reduceMax;                     // Maximum number of samples removed from a frame
+
+    // Continuous waveform related
+    unsigned waveChunkLen;                  // Number of samples per wave chunk, 0: discrete frames
+    unsigned waveShift;                     // Color shift (delay line, continues across frames)
+    uint8_t *waveColorLine;                 // Color delay line (waveShift RGB entries)
+    unsigned waveColorPos;                  // Current delay line entry
+    uint8_t *waveBufferPtr;                 // Wave chunk buffer (headroom, chunk header, samples)
+    unsigned waveFill;                      // Number of samples in the wave chunk buffer
+    uint64_t waveStart;                     // Sample clock reference (ns)
+    uint64_t waveClock;                     // Number of samples sent (sample clock)
+    uint32_t waveChunkCnt;                  // Number of wave chunks sent
+    uint8_t *waveHoldPtr;                   // Samples of the first frame (hold single-frame files)
+    unsigned waveHoldCnt;                   // Number of samples of the first frame
+
+    // Decoder/sender pipeline related
+    FRAME_QUEUE *frameQueue;                // Frames decoded ahead of the sender, null: send inline
+    uint32_t decodeCnt;                     // Number of decoded frames (decoder side)
+    uint64_t decodeSampleCnt;               // Number of decoded samples (decoder side)
+    int holdFrameFlag;                      // Keep a copy of the next frame pushed (repeated later)
+    uint8_t *holdFramePtr;                  // Copy of the sample chunk to repeat
+    unsigned holdFrameLen;                  // Length of the sample chunk copy
+
+    // Preloading related
+    SHOW *show;                             // Collect the decoded frames, null: send them
+
+} IDNCONTEXT;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+// Note: The stream context is driven by one thread at a time. With a frame queue, the decoder
+// side (open/put/push) and the sender side (see idnRunSender) may run on two threads.
+void idnSetLogFunc(IDN_LOG_FUNC func, void *context);
+void idnLogError(const char *fmt, ...);
+void idnLogInfo(const char *fmt, ...);
+
+int idnEnsureBuffer(IDNCONTEXT *ctx, unsigned minLen);
+int idnShowAppend(SHOW *show, uint8_t *bufferPtr, unsigned dataOffset, unsigned dataEnd);
+void idnShowFree(SHOW *show);
+
+int idnReceiveAck(IDNCONTEXT *ctx, const uint8_t *buffer, unsigned length, uint64_t now);
+void idnPollAck(IDNCONTEXT *ctx);
+void idnReportAck(IDNCONTEXT *ctx, const char *prefix);
+
+int idnSendVoid(IDNCONTEXT *ctx);
+int idnKeepalive(IDNCONTEXT *ctx, uint64_t until);
+uint64_t idnFrameDeadline(IDNCONTEXT *ctx);
+int idnWaitDeadline(IDNCONTEXT *ctx, uint64_t *deadlinePtr);
+int idnSendFrame(IDNCONTEXT *ctx, uint8_t *bufferPtr, unsigned chunkOffset, unsigned payloadEnd, uint64_t deadline);
+int idnFlushWave(IDNCONTEXT *ctx);
+int idnSendWave(IDNCONTEXT *ctx, const uint8_t *samplePtr, unsigned sampleCnt);
+int idnRunSender(IDNCONTEXT *ctx);
+
+int idnOpenFrameXYRGB(void *context);
+int idnPutSampleXYRGB(void *context, int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b);
+int idnPushFrameXYRGB(void *context);
+int idnFinishFrameXYRGB(IDNCONTEXT *ctx, unsigned *payloadEndPtr);
+void idnSwapFrameBuffer(IDNCONTEXT *ctx, FRAME_QUEUE_SLOT *slot, unsigned payloadEnd);
+int idnRepeatFrame(IDNCONTEXT *ctx, unsigned repeatCnt);
+int idnSendShowFrame(IDNCONTEXT *ctx, SHOW_FRAME *frame, uint64_t deadline);
+
+int idnSendChannelClose(IDNCONTEXT *ctx);
+int idnSendClose(void *context);
+
+
+#endif
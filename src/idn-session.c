@@ -0,0 +1,362 @@
+// -------------------------------------------------------------------------------------------------
+//  File idn-session.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created (embeddable streaming API)
+//  10/2026 DexLogic, frames from several producer threads (lock-free queue)
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+// Platform includes
+#if defined(_WIN32) || defined(WIN32)
+
+    #include <windows.h>
+
+    #include "plt-windows.h"
+
+#else
+
+    #include <arpa/inet.h>
+
+    #include "plt-posix.h"
+
+#endif
+
+
+// Project headers
+#include "idn-context.h"
+#include "mpsc-queue.h"
+
+// Module header
+#include "idn-session.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+struct _IDNS_WRITER
+{
+    IDNS_SESSION *session;                  // Session the frames are submitted to
+    IDNCONTEXT encoder;                     // Frame encoding state of this writer (work buffer)
+    FRAME_QUEUE_SLOT *slot;                 // Queue slot of the open frame
+    uint32_t ticket;                        // Position of the open frame in the stream
+    int openFlag;                           // Frame open (slot reserved)
+
+};
+
+
+struct _IDNS_SESSION
+{
+    IDNCONTEXT ctx;                         // Stream (sender thread, encoder settings for the writers)
+    MPSC_QUEUE *queue;                      // Frames submitted by the writers, in stream order
+    PLT_THREAD thread;                      // Sender thread
+    int threadRc;                           // Result of the sender thread
+
+};
+
+
+// -------------------------------------------------------------------------------------------------
+//  Sender
+// -------------------------------------------------------------------------------------------------
+
+static FRAME_QUEUE_SLOT *idnsWaitFrame(IDNS_SESSION *ssn)
+{
+    // Wait for the writers. While they stall, keep the channel alive (see idnWaitFrame).
+    IDNCONTEXT *ctx = &ssn->ctx;
+    while(1)
+    {
+        uint64_t due = (ctx->keepaliveNS && ctx->lastTxTime) ? ctx->lastTxTime + ctx->keepaliveNS : 0;
+
+        int timeoutFlag;
+        FRAME_QUEUE_SLOT *slot = mpqGetBeginUntil(ssn->queue, due, &timeoutFlag);
+        if(!timeoutFlag) return slot;
+
+        if(idnSendVoid(ctx)) return (FRAME_QUEUE_SLOT *)0;
+    }
+}
+
+
+static int idnsRunSender(IDNS_SESSION *ssn)
+{
+    // Send the frames in stream order, until the session is closed. Note: Unlike idnRunSender,
+    // the frame is taken before its deadline: A discarded frame leaves an empty slot, which is
+    // dropped without taking a place in the schedule.
+    IDNCONTEXT *ctx = &ssn->ctx;
+    FRAME_QUEUE_SLOT *slot;
+    while((slot = idnsWaitFrame(ssn)) != (FRAME_QUEUE_SLOT *)0)
+    {
+        int rc = 0;
+        uint64_t deadline = 0;
+        if(slot->dataLen && !idnWaitDeadline(ctx, &deadline))
+        {
+            rc = idnSendFrame(ctx, slot->bufferPtr, slot->dataOffset, slot->dataOffset + slot->dataLen, deadline);
+        }
+        mpqGetEnd(ssn->queue);
+
+        // Send error: Refuse further frames
+        if(rc) { mpqAbort(ssn->queue); return -1; }
+    }
+
+    return 0;
+}
+
+
+static PLT_THREAD_RESULT PLT_THREAD_CALL idnsSenderThread(void *arg)
+{
+    IDNS_SESSION *ssn = (IDNS_SESSION *)arg;
+
+    // Pace and send the frames until the session is closed (queue drained)
+    ssn->threadRc = idnsRunSender(ssn);
+
+    return 0;
+}
+
+
+static void idnsFree(IDNS_SESSION *ssn)
+{
+    if(ssn->queue) mpqDestroy(ssn->queue);
+    if(ssn->ctx.fdSocket >= 0) plt_sockClose(ssn->ctx.fdSocket);
+    plt_sockCleanup();
+    free(ssn);
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  API
+// -------------------------------------------------------------------------------------------------
+
+void idnsInitConfig(IDNS_CONFIG *cfg)
+{
+    memset(cfg, 0, sizeof(IDNS_CONFIG));
+    cfg->frameRate = DEFAULT_FRAMERATE;
+    cfg->scanSpeed = DEFAULT_SCANSPEED;
+    cfg->keepaliveTime = DEFAULT_KEEPALIVE;
+    cfg->latePolicy = IDNS_LATE_SEND;
+    cfg->queueDepth = IDNS_DEFAULT_QUEUE_DEPTH;
+}
+
+
+IDNS_SESSION *idnsOpen(const IDNS_CONFIG *cfg)
+{
+    if(!cfg->serverAddr || (cfg->frameRate < 5) || !cfg->scanSpeed || !cfg->queueDepth) return (IDNS_SESSION *)0;
+    if(cfg->logFunc) idnSetLogFunc(cfg->logFunc, cfg->logContext);
+    if(plt_validateMonoTime()) { idnLogError("[IDNS] Monotonic time init failed"); return (IDNS_SESSION *)0; }
+
+    IDNS_SESSION *ssn = (IDNS_SESSION *)calloc(1, sizeof(IDNS_SESSION));
+    if(!ssn) return (IDNS_SESSION *)0;
+
+    // Stream settings (same as the player for a single target, user-space pacing)
+    IDNCONTEXT *ctx = &ssn->ctx;
+    ctx->fdSocket = -1;
+    ctx->serverSockAddr.sin_family = AF_INET;
+    ctx->serverSockAddr.sin_port = htons(IDNVAL_HELLO_UDP_PORT);
+    ctx->serverSockAddr.sin_addr.s_addr = cfg->serverAddr;
+    ctx->clientGroup = cfg->clientGroup;
+    ctx->serviceID = cfg->serviceID;
+    ctx->serviceMode = IDNVAL_SMOD_LPGRF_DISCRETE;
+    ctx->frameRate = cfg->frameRate;
+    ctx->usFrameTime = 1000000 / cfg->frameRate;
+    ctx->latePolicy = cfg->latePolicy;
+    ctx->keepaliveNS = (uint64_t)cfg->keepaliveTime * 1000000;
+    ctx->ackIntervalNS = (uint64_t)cfg->ackInterval * 1000000;
+    ctx->ackPollFlag = 1;
+    ctx->jitterFreeFlag = cfg->jitterFreeFlag;
+    ctx->scanSpeed = cfg->scanSpeed;
+    ctx->colorShift = cfg->colorShift;
+    ctx->txTimeClock = -1;
+    ctx->startTime = plt_getMonoTimeNS();
+
+    int rcStartup = plt_sockStartup();
+    if(rcStartup)
+    {
+        idnLogError("[IDNS] Socket startup failed (error: %d)", rcStartup);
+        free(ssn);
+        return (IDNS_SESSION *)0;
+    }
+
+    ctx->fdSocket = plt_sockOpen(AF_INET, SOCK_DGRAM, 0);
+    if(ctx->fdSocket < 0)
+    {
+        idnLogError("[IDNS] socket() failed (error: %d)", plt_sockGetLastError());
+        idnsFree(ssn);
+        return (IDNS_SESSION *)0;
+    }
+
+    ssn->queue = mpqCreate(cfg->queueDepth);
+    if(!ssn->queue || plt_threadCreate(&ssn->thread, idnsSenderThread, ssn))
+    {
+        idnLogError("[IDNS] Sender setup failed");
+        idnsFree(ssn);
+        return (IDNS_SESSION *)0;
+    }
+
+    return ssn;
+}
+
+
+int idnsClose(IDNS_SESSION *ssn)
+{
+    // Note: The writers are done (frames begun are submitted or discarded), the queued frames are sent
+    mpqClose(ssn->queue);
+    plt_threadJoin(ssn->thread);
+
+    // Close the channel and the session (sender thread gone)
+    int rc = ssn->threadRc;
+    if(ssn->ctx.frameCnt && idnSendClose(&ssn->ctx)) rc = -1;
+
+    idnsFree(ssn);
+
+    return rc;
+}
+
+
+IDNS_WRITER *idnsCreateWriter(IDNS_SESSION *ssn)
+{
+    IDNS_WRITER *wr = (IDNS_WRITER *)calloc(1, sizeof(IDNS_WRITER));
+    if(!wr) return (IDNS_WRITER *)0;
+    wr->session = ssn;
+
+    // Encoder settings of the session (the sender side of the encoder context is not used)
+    IDNCONTEXT *enc = &wr->encoder;
+    enc->fdSocket = -1;
+    enc->frameRate = ssn->ctx.frameRate;
+    enc->usFrameTime = ssn->ctx.usFrameTime;
+    enc->scanSpeed = ssn->ctx.scanSpeed;
+    enc->colorShift = ssn->ctx.colorShift;
+    enc->jitterFreeFlag = ssn->ctx.jitterFreeFlag;
+
+    return wr;
+}
+
+
+void idnsDestroyWriter(IDNS_WRITER *wr)
+{
+    // Note: An open frame is discarded (the sender must not wait for it)
+    if(wr->openFlag) idnsDiscardFrame(wr);
+
+    frmFree(&wr->encoder.processSource);
+    frmFree(&wr->encoder.processTarget);
+    if(wr->encoder.bufferPtr) free(wr->encoder.bufferPtr);
+    free(wr);
+}
+
+
+int idnsBeginFrame(IDNS_WRITER *wr, uint32_t *frameNumberPtr)
+{
+    // One frame at a time per writer
+    if(wr->openFlag) return IDNS_ERROR;
+    if(idnOpenFrameXYRGB(&wr->encoder)) return IDNS_ERROR;
+
+    // Take the place in the stream
+    int fullFlag;
+    wr->slot = mpqReserve(wr->session->queue, &wr->ticket, &fullFlag);
+    if(!wr->slot)
+    {
+        // Sender gone (send error) or no room
+        wr->encoder.payloadLen = 0;
+        return fullFlag ? IDNS_AGAIN : IDNS_ERROR;
+    }
+
+    if(frameNumberPtr) *frameNumberPtr = wr->ticket;
+    wr->openFlag = 1;
+    return IDNS_OK;
+}
+
+
+int idnsPutSample(IDNS_WRITER *wr, int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b)
+{
+    if(!wr->openFlag) return IDNS_ERROR;
+
+    return idnPutSampleXYRGB(&wr->encoder, x, y, r, g, b) ? IDNS_ERROR : IDNS_OK;
+}
+
+
+int idnsSubmitFrame(IDNS_WRITER *wr)
+{
+    if(!wr->openFlag) return IDNS_ERROR;
+
+    // Complete the frame (headers, processing) and hand it over in its slot. Note: Jitter-free,
+    // only the first frame of the stream is scanned repeatedly (whichever writer it came from)
+    unsigned payloadEnd;
+    wr->encoder.decodeCnt = wr->ticket;
+    if(idnFinishFrameXYRGB(&wr->encoder, &payloadEnd))
+    {
+        idnsDiscardFrame(wr);
+        return IDNS_ERROR;
+    }
+
+    idnSwapFrameBuffer(&wr->encoder, wr->slot, payloadEnd);
+    mpqCommit(wr->session->queue, wr->ticket);
+    wr->openFlag = 0;
+
+    return IDNS_OK;
+}
+
+
+void idnsDiscardFrame(IDNS_WRITER *wr)
+{
+    if(!wr->openFlag) return;
+
+    // Hand over an empty slot, the sender skips it. Note: The work buffer is kept for the next frame
+    wr->encoder.payloadLen = 0;
+    wr->slot->dataLen = 0;
+    mpqCommit(wr->session->queue, wr->ticket);
+    wr->openFlag = 0;
+}
+
+
+void idnsGetStats(IDNS_SESSION *ssn, IDNS_STATS *stats)
+{
+    // Note: Sender side counters are read while the sender runs (a snapshot, not consistent)
+    MPSC_QUEUE_STATS mpqStats;
+    mpqGetStats(ssn->queue, &mpqStats);
+
+    memset(stats, 0, sizeof(IDNS_STATS));
+    stats->submitCnt = mpqStats.reserveCnt;
+    stats->againCnt = mpqStats.fullCnt;
+    stats->sendCnt = mpqStats.getCnt;
+    stats->retryCnt = mpqStats.retryCnt;
+    stats->stallCnt = mpqStats.stallCnt;
+    stats->frameCnt = ssn->ctx.frameCnt;
+    stats->lateCnt = ssn->ctx.lateCnt;
+    stats->skipCnt = ssn->ctx.skipCnt;
+    stats->voidCnt = ssn->ctx.voidCnt;
+    stats->ackReqCnt = ssn->ctx.ackReqCnt;
+    stats->ackCnt = ssn->ctx.ackCnt;
+    stats->ackLostCnt = ssn->ctx.ackLostCnt;
+    stats->rttMin = ssn->ctx.ackRttMin;
+    stats->rttAvg = ssn->ctx.ackCnt ? (uint32_t)(ssn->ctx.ackRttSum / ssn->ctx.ackCnt) : 0;
+    stats->rttMax = ssn->ctx.ackRttMax;
+    stats->ackResult = (int8_t)ssn->ctx.ackResult;
+    stats->ackEvents = ssn->ctx.ackEvents;
+}
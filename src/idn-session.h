@@ -0,0 +1,142 @@
+// -------------------------------------------------------------------------------------------------
+//  File idn-session.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created (embeddable streaming API)
+//  10/2026 DexLogic, frames from several producer threads (lock-free queue)
+// -------------------------------------------------------------------------------------------------
+
+
+#ifndef IDN_SESSION_H
+#define IDN_SESSION_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define IDNS_OK                         0           // Call succeeded
+#define IDNS_AGAIN                      1           // Queue full, no frame begun (begin again later)
+#define IDNS_ERROR                      -1          // Invalid call or session failed
+
+#define IDNS_LATE_SEND                  0           // Late frame: Send, shift the schedule
+#define IDNS_LATE_SKIP                  1           // Late frame: Drop, keep the schedule
+#define IDNS_LATE_CATCHUP               2           // Late frame: Send, keep the schedule
+
+#define IDNS_DEFAULT_QUEUE_DEPTH        4           // Frames submitted ahead of the sender
+
+#define IDNS_LOG_ERROR                  0           // Log levels passed to the log function
+#define IDNS_LOG_INFO                   1
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct _IDNS_SESSION IDNS_SESSION;
+typedef struct _IDNS_WRITER IDNS_WRITER;
+
+// Note: Called by any thread of the library, one complete line per call (no newline)
+typedef void (*IDNS_LOG_FUNC)(void *context, int level, const char *message);
+
+typedef struct
+{
+    uint32_t serverAddr;                    // IPv4 address of the IDN-Hello server (network byte order)
+    uint8_t clientGroup;                    // Client group to send on (0..15)
+    uint8_t serviceID;                      // Service ID to use (0: default service)
+    unsigned frameRate;                     // Number of frames per second
+    unsigned scanSpeed;                     // Number of samples per second
+    unsigned colorShift;                    // Color shift in samples
+    int jitterFreeFlag;                     // Scan frames only once to exactly match the frame rate
+    unsigned keepaliveTime;                 // Void message after this much silence (ms), 0: off
+    unsigned ackInterval;                   // Request an acknowledge this often (ms), 0: off
+    int latePolicy;                         // What to do with a frame that missed its deadline
+    unsigned queueDepth;                    // Number of frames submitted ahead of the sender
+    IDNS_LOG_FUNC logFunc;                  // Library messages (all sessions, last one set), 0: silent
+    void *logContext;                       // Passed to the log function
+
+} IDNS_CONFIG;
+
+typedef struct
+{
+    uint64_t submitCnt;                     // Number of frames begun (queue slots reserved)
+    uint64_t againCnt;                      // Number of begins refused (queue full)
+    uint64_t sendCnt;                       // Number of frames taken by the sender
+    uint32_t retryCnt;                      // Number of begins retried (lost to another writer)
+    uint32_t stallCnt;                      // Sender waited for a frame begun but not submitted yet
+    uint32_t frameCnt;                      // Number of frames sent
+    uint32_t lateCnt;                       // Number of frames that missed their deadline
+    uint32_t skipCnt;                       // Number of frames dropped because of lateness
+    uint32_t voidCnt;                       // Number of void messages (no frame submitted in time)
+    uint32_t ackReqCnt;                     // Number of acknowledges requested
+    uint32_t ackCnt;                        // Number of acknowledges received
+    uint32_t ackLostCnt;                    // Number of requests unanswered until the next one was due
+    uint32_t rttMin;                        // Round-trip time of the acknowledges (microseconds)
+    uint32_t rttAvg;
+    uint32_t rttMax;
+    int8_t ackResult;                       // Result of the last acknowledge (<0: stream rejected)
+    uint16_t ackEvents;                     // Event flags of all acknowledges (new connection, sequence errors)
+
+} IDNS_STATS;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+// Note: A session streams to one IDN-Hello server. The frames are paced and sent by a thread of
+// the session. Several application threads can produce frames, each with its own writer (a writer
+// is used by one thread at a time). Beginning a frame reserves its place in the stream, the frames
+// are sent in that order, whichever writer submits first. No call blocks: A begin that finds the
+// queue full returns IDNS_AGAIN. A frame begun has to be submitted or discarded, the sender waits
+// for it. C linkage: The library is built as C++, the API is callable from C as well.
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void idnsInitConfig(IDNS_CONFIG *cfg);
+IDNS_SESSION *idnsOpen(const IDNS_CONFIG *cfg);
+int idnsClose(IDNS_SESSION *ssn);
+
+IDNS_WRITER *idnsCreateWriter(IDNS_SESSION *ssn);
+void idnsDestroyWriter(IDNS_WRITER *wr);
+
+int idnsBeginFrame(IDNS_WRITER *wr, uint32_t *frameNumberPtr);
+int idnsPutSample(IDNS_WRITER *wr, int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b);
+int idnsSubmitFrame(IDNS_WRITER *wr);
+void idnsDiscardFrame(IDNS_WRITER *wr);
+
+void idnsGetStats(IDNS_SESSION *ssn, IDNS_STATS *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+
+#endif
@@ -57,8 +57,8 @@
 //  Prototypes
 // -------------------------------------------------------------------------------------------------
 
-void logError(const char *fmt, ...);
-void logInfo(const char *fmt, ...);
+void idnLogError(const char *fmt, ...);
+void idnLogInfo(const char *fmt, ...);
 
 
 // -------------------------------------------------------------------------------------------------
@@ -589,16 +589,13 @@ static unsigned long ildaStandardPalette[256] =     // ILDA color palette standa
 };
 
 
-static unsigned long customPalette[256];
-
-
 // -------------------------------------------------------------------------------------------------
 //  Code
 // -------------------------------------------------------------------------------------------------
 
 inline static int checkEOF(FILE *fp, const char *dbgText)
 {
-    if(feof(fp)) { logError("[IDTF] Unexpected end of file (%s)", dbgText); return -1; }
+    if(feof(fp)) { idnLogError("[IDTF] Unexpected end of file (%s)", dbgText); return -1; }
 
     return 0;
 }
@@ -624,7 +621,10 @@ int idtfRead(char *filename, float xyScale, unsigned options, IDTF_CALLBACK_FUNC
     unsigned long *currentPalette = ildaDefaultPalette;
     if((palOption == 0) || (palOption == IDTFOPT_PALETTE_IDTF_DEFAULT)) { }
     else if(palOption == IDTFOPT_PALETTE_ILDA_STANDARD) { currentPalette = ildaStandardPalette; }
-    else { logError("[IDTF] Invalid palette option"); return -1; }
+    else { idnLogError("[IDTF] Invalid palette option"); return -1; }
+
+    // Note: Palette sections of the file are kept locally (several files can be read concurrently)
+    unsigned long customPalette[256];
 
     float xScale = (options & IDTFOPT_MIRROR_X) ? -xyScale : xyScale;
     float yScale = (options & IDTFOPT_MIRROR_Y) ? -xyScale : xyScale;
@@ -633,7 +633,7 @@ int idtfRead(char *filename, float xyScale, unsigned options, IDTF_CALLBACK_FUNC
     FILE *fpIDTF = plt_fopen(filename, "rb");
     if(!fpIDTF) 
     {
-        logError("[IDTF] %s: Cannot open file (errno: %d)", filename, errno);
+        idnLogError("[IDTF] %s: Cannot open file (errno: %d)", filename, errno);
         return -1;
     }
 
@@ -668,7 +668,7 @@ int idtfRead(char *filename, float xyScale, unsigned options, IDTF_CALLBACK_FUNC
     // Check for EOF and the signature of first section
     if(feof(fpIDTF) || !((ilda[0] == 'I') && (ilda[1] == 'L') && (ilda[2] == 'D') && (ilda[3] == 'A')))
     {
-        logError("[IDTF] %s: Not an IDTF file", filename);
+        idnLogError("[IDTF] %s: Not an IDTF file", filename);
         fclose(fpIDTF);
         return -1;
     }
@@ -687,7 +687,16 @@ int idtfRead(char *filename, float xyScale, unsigned options, IDTF_CALLBACK_FUNC
         // Read section signature. Silently abort in case of (incorrect) EOF.
         filePos = ftell(fpIDTF);
         fread(ilda, sizeof(ilda), 1, fpIDTF);
-        if(feof(fpIDTF)) break;
+        if(feof(fpIDTF))
+        {
+            // Note: A file being written may end at any section boundary
+            if(options & IDTFOPT_REQUIRE_END)
+            {
+                idnLogError("[IDTF] %s: No end section at pos 0x%08X, file incomplete", filename, filePos);
+                result = -1;
+            }
+            break;
+        }
 
         // Some systems use this signature before appending further (non-IDTF) data...
         if((ilda[0] == 0) && (ilda[1] == 0) && (ilda[2] == 0) && (ilda[3] == 0)) break;
@@ -695,7 +704,7 @@ int idtfRead(char *filename, float xyScale, unsigned options, IDTF_CALLBACK_FUNC
         // Check for IDTF section signature
         if(!((ilda[0] == 'I') && (ilda[1] == 'L') && (ilda[2] == 'D') && (ilda[3] == 'A')))
         {
-            logError("[IDTF] %s: Bad section signature at pos 0x%08X", filename, filePos);
+            idnLogError("[IDTF] %s: Bad section signature at pos 0x%08X", filename, filePos);
             result = -1;
             break;
         }
@@ -713,21 +722,21 @@ int idtfRead(char *filename, float xyScale, unsigned options, IDTF_CALLBACK_FUNC
         fread(companyName, 8, 1, fpIDTF);
         if((result = checkEOF(fpIDTF, "Header")) != 0) break;
 
-        //logInfo("dataSetName: %8.8s", dataSetName);
-        //logInfo("companyName: %8.8s", companyName);
+        //idnLogInfo("dataSetName: %8.8s", dataSetName);
+        //idnLogInfo("companyName: %8.8s", companyName);
 
         // Read record count and data set number (frame number or color palette number)
         uint16_t recordCnt = (uint16_t)readShort(fpIDTF);
         uint16_t dataSetNumber = (uint16_t)readShort(fpIDTF);
         if((result = checkEOF(fpIDTF, "Header")) != 0) break;
 
-        // Read data set count (not used) and head number (not used)
+        // Read data set count (not used) and head number (frames routed by the callback)
         uint16_t dataSetCnt = (uint16_t)readShort(fpIDTF);
         uint8_t headNumber = (uint8_t)fgetc(fpIDTF);
         fgetc(fpIDTF);
 
-        //logInfo("Format: %d, Records: %d, Set number: %d, Set count: %d, Head: %d",
-        //        formatCode, recordCnt, dataSetNumber, dataSetCnt, headNumber);
+        //idnLogInfo("Format: %d, Records: %d, Set number: %d, Set count: %d, Head: %d",
+        //           formatCode, recordCnt, dataSetNumber, dataSetCnt, headNumber);
 
         // Terminate in case of an empty section (no records - regular end)
         if(recordCnt == 0) break;
@@ -735,12 +744,12 @@ int idtfRead(char *filename, float xyScale, unsigned options, IDTF_CALLBACK_FUNC
         // Handle data section depending on format code
         if((formatCode == 0) || (formatCode == 1) || (formatCode == 4) || (formatCode == 5)) 
         {
-            //logInfo("Frame, fmt=%u, filePos 0x%08X", formatCode, filePos);
+            //idnLogInfo("Frame, fmt=%u, filePos 0x%08X", formatCode, filePos);
 
             // Terminate on insane frames
             if(recordCnt <= 1)
             {
-                logError("[IDTF] %s: Frames should contain at least 2 points", filename); 
+                idnLogError("[IDTF] %s: Frames should contain at least 2 points", filename); 
                 result = -1;
                 break;
             }
@@ -751,8 +760,17 @@ int idtfRead(char *filename, float xyScale, unsigned options, IDTF_CALLBACK_FUNC
             // Formats 0 and 1 have color index; Formats 4 and 5 are true color RGB.
             int hasIndex = (formatCode == 0) || (formatCode == 1);
 
+            // Select the output of the head, skip frames of heads not played
+            void *frameContext = cbFunc->selectHead ? cbFunc->selectHead(cbContext, headNumber) : cbContext;
+            if(!frameContext)
+            {
+                long recordSize = (hasZ ? 6 : 4) + 1 + (hasIndex ? 1 : 3);
+                fseek(fpIDTF, recordCnt * recordSize, SEEK_CUR);
+                continue;
+            }
+
             // Tell the output to open a frame
-            if(cbFunc->openFrame(cbContext)) { result = -1; break; }
+            if(cbFunc->openFrame(frameContext)) { result = -1; break; }
 
             // Loop through all points
             for(int i = 0; i < recordCnt; i++)
@@ -790,42 +808,42 @@ int idtfRead(char *filename, float xyScale, unsigned options, IDTF_CALLBACK_FUNC
                 // Check for unexpected EOF
                 if(feof(fpIDTF)) 
                 { 
-                    logError("[IDTF] Unexpected end of file: Record %u of %u", i, recordCnt); 
+                    idnLogError("[IDTF] Unexpected end of file: Record %u of %u", i, recordCnt); 
                     result = -1;
                     break;
                 }
 
                 // Output the point
                 if(statusCode & 0x40) r = g = b = 0;
-                if(cbFunc->putSampleXYRGB(cbContext, x, y, r, g, b)) { result = -1; break; }
+                if(cbFunc->putSampleXYRGB(frameContext, x, y, r, g, b)) { result = -1; break; }
 
                 // Check the status code (last point) against the record counter
                 int lastPointFlag = ((statusCode & 0x80) != 0);
                 int lastRecordFlag = ((i + 1) == recordCnt);
                 if(lastPointFlag && !lastRecordFlag)
                 {
-                    logError("[IDTF] Last point flag set, record count mismatch: Record %u of %u, file pos 0x%08X", i, recordCnt, filePos);
+                    idnLogError("[IDTF] Last point flag set, record count mismatch: Record %u of %u, file pos 0x%08X", i, recordCnt, filePos);
                     result = -1;
                     break;
                 }
                 else if(!lastPointFlag && lastRecordFlag)
                 {
-                    logError("[IDTF] Last point flag not set on last record: File pos 0x%08X", filePos);
+                    idnLogError("[IDTF] Last point flag not set on last record: File pos 0x%08X", filePos);
                 }
             }
             if(result != 0) break;
 
             // Tell the output to push the frame
-            if(cbFunc->pushFrame(cbContext)) { result = -1; break; }
+            if(cbFunc->pushFrame(frameContext)) { result = -1; break; }
         }
         else if(formatCode == 2)
         {
-            //logInfo("Palette, filePos 0x%08X", formatCode, filePos);
+            //idnLogInfo("Palette, filePos 0x%08X", formatCode, filePos);
 
             // Terminate on insane palettes
             if(recordCnt > 256)
             {
-                logError("[IDTF] %s: Palettes shall not contain more than 256 colors", filename); 
+                idnLogError("[IDTF] %s: Palettes shall not contain more than 256 colors", filename); 
                 result = -1;
                 break;
             }
@@ -844,7 +862,7 @@ int idtfRead(char *filename, float xyScale, unsigned options, IDTF_CALLBACK_FUNC
                 // Check for unexpected EOF
                 if(feof(fpIDTF)) 
                 { 
-                    logError("[IDTF] Unexpected end of file: Record %u of %u", i, recordCnt); 
+                    idnLogError("[IDTF] Unexpected end of file: Record %u of %u", i, recordCnt); 
                     result = -1;
                     break;
                 }
@@ -859,7 +877,7 @@ int idtfRead(char *filename, float xyScale, unsigned options, IDTF_CALLBACK_FUNC
         }
         else
         {
-            logError("[IDTF] %s: formatCode = %d", filename, formatCode);
+            idnLogError("[IDTF] %s: formatCode = %d", filename, formatCode);
             result = -1;
             break;
         }
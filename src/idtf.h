@@ -48,6 +48,8 @@
 #define IDTFOPT_MIRROR_X                0x0100      // Mirror x axis
 #define IDTFOPT_MIRROR_Y                0x0200      // Mirror y axis
 
+#define IDTFOPT_REQUIRE_END             0x1000      // Missing end section is an error (incomplete file)
+
 
 // -------------------------------------------------------------------------------------------------
 //  Typedefs
@@ -59,6 +61,9 @@ typedef struct
     int (* putSampleXYRGB)(void *context, int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b);
     int (* pushFrame)(void *context);
 
+    // Optional: Context for the frames of a head (projector), 0: skip the section
+    void *(* selectHead)(void *context, uint8_t headNumber);
+
 } IDTF_CALLBACK_FUNC;
 
 
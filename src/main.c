@@ -27,6 +27,13 @@
 //  05/2016 Dirk Apitz, created
 //  06/2016 Dirk Apitz, color shift, fragmented frames, scale, mirror
 //  08/2016 Theo Dari / Dirk Apitz, Windows port
+//  10/2026 DexLogic, command line client of the stream engine library (libidtfplayer.a)
+// -------------------------------------------------------------------------------------------------
+//  Note: Encoding, pacing, shaping and sending are the library (idn-context.h, embedded through
+//  idn-session.h). The playback modes stay in this file: Sessions and shards, heads, show scripts,
+//  the daemon with hot reload, playlists and the acknowledge dispatch. They are driven by the
+//  command line, files and a control socket, so an embedding application has no use for them.
+//  Each one runs its own event loop directly on the library context.
 // -------------------------------------------------------------------------------------------------
 
 // Standard libraries
@@ -55,22 +62,38 @@
 
 
 // Project headers
-#include "idn-hello.h"
-#include "idn-stream.h"
+#include "idn-context.h"
 #include "idtf.h"
+#include "evloop.h"
+#include "workpool.h"
+#include "script.h"
+#include "ping-probe.h"
 
 
 // -------------------------------------------------------------------------------------------------
 //  Defines
 // -------------------------------------------------------------------------------------------------
 
-#define DEFAULT_FRAMERATE               30
-#define DEFAULT_SCANSPEED               30000
+#define PREFAULT_STACK_SIZE             0x40000     // Sender stack touched ahead with -mlock
+#define PREFAULT_BUFFER_SIZE            0x40000     // Frame buffers allocated ahead with -mlock
 
-#define MAX_IDN_MESSAGE_LEN             0xFF00      // IDN-Message maximum length (due to lower layer transport)
-//#define MAX_IDN_MESSAGE_LEN             0x0800      // Message len for fragmentation tests
+#define MAX_SESSION_LINE                1024        // Maximum line length of a sessions file
+#define MAX_SESSION_ARGS                32          // Maximum number of options per session
+#define SESSION_FRAME_COST              4096        // Send cost of a frame in bytes (system call), for balancing
+#define MAX_HEADS                       16          // Maximum number of heads routed to outputs
+#define MAX_PLAYLIST                    64          // Maximum number of files played back to back
+#define SYNC_START_DELAY                500         // Time from starting a timeline to its first frame (ms)
+#define MAX_DAEMON_CUES                 64          // Maximum number of shows kept decoded by the daemon
+#define MAX_DAEMON_CLIENTS              8           // Maximum number of control connections
+#define DEFAULT_PINGTIME                10          // Run time of a probe without stream (seconds)
 
-#define XYRGB_SAMPLE_SIZE               7
+#define WATCH_SETTLE_TIME               100         // Time without further changes before a file is reloaded (ms)
+#define WATCH_POLL_TIME                 10          // Interval checking a background decode for completion (ms)
+#define DAEMON_OP_NONE                  0           // No command pending
+#define DAEMON_OP_PLAY                  1           // Play a show from the given frame
+#define DAEMON_OP_STOP                  2           // Close the channel, keep the session
+#define DAEMON_OP_QUIT                  3           // Close the session, leave
+#define DAEMON_OP_SWITCH                4           // Play a show from the position of the current one
 
 
 // -------------------------------------------------------------------------------------------------
@@ -79,510 +102,1769 @@
 
 typedef struct
 {
-    int fdSocket;                           // Socket file descriptor
-    struct sockaddr_in serverSockAddr;      // Target server address
-    unsigned char clientGroup;              // Client group to send on
-    unsigned char serviceID;                // ServiceID to use
-    unsigned usFrameTime;                   // Time for one frame in microseconds (1000000/frameRate)
-    int jitterFreeFlag;                     // Scan frames only once to exactly match frame rate
-    unsigned scanSpeed;                     // Scan speed in samples per second
-    unsigned colorShift;                    // Color shift in points/samples
+    char **filenames;                       // IDTF files to decode (playlist)
+    unsigned fileCnt;                       // Number of playlist files
+    unsigned holdTime;                      // Time in seconds to display single-frame files
+    float xyScale;                          // Scale factor
+    unsigned options;                       // IDTF reader options
+    IDTF_CALLBACK_FUNC *cbFunc;             // Frame encoder callbacks
+    IDNCONTEXT *ctx;                        // Driver function context
+    int rc;                                 // Result of the IDTF reader
+
+} DECODER_TASK;
+
+
+typedef struct
+{
+    IDNCONTEXT ctx;                         // Stream (own target, frame rate, client group, service ID)
+    char *idtfFilename;                     // IDTF file to play
+    float xyScale;                          // Scale factor
+    unsigned options;                       // IDTF reader options
+    unsigned holdTime;                      // Time in seconds to display single-frame files
+
+    SHOW show;                              // Decoded frames
+    unsigned frameIndex;                    // Next frame to send
+    uint64_t dueTime;                       // Time of the next frame (or of the close after a hold)
+    EVLOOP *evl;                            // Event loop driving the session
+    EVLOOP_TIMER timer;                     // Next frame or keepalive
+    int doneFlag;                           // Channel closed
+    int decodeRc;                           // Result of the IDTF reader
+    uint64_t load;                          // Estimated send load (bytes per second, see SESSION_FRAME_COST)
+    int headNumber;                         // Head (projector) of the file played, -1: all frames
+    IDN_CONNECTION connection;              // IDN-Hello session of the server (used by the first session only)
+
+    char *scriptFilename;                   // Show script to run instead of the IDTF file, 0: none
+    SCRIPT script;                          // Statements of the show script
+    SCRIPT_RUN run;                         // Show script state (statement, frame, waiting for)
+    SHOW *scriptShows;                      // Decoded frames of the script files
+    int scriptAct;                          // What the script waits for (see SCRIPT_ACT_*)
+    SHOW_FRAME *heldFrame;                  // Frame of the script not sent yet (shaper debt), 0: none
+    int cueFlag;                            // Script woken up by its cue
+    int playFlag;                           // Channel open (frames sent since the last stop)
+    unsigned *activeCnt;                    // Sessions of the event loop not done (acknowledge watch), 0: none
+
+} IDN_SESSION;
+
+
+typedef struct
+{
+    uint8_t headNumber;                     // Head number of the IDTF frame sections
+    in_addr_t serverAddr;                   // IDN-Hello server of the head
+    int serviceID;                          // Service ID of the head, -1: from the command line
 
-    unsigned bufferLen;                     // Length of work buffer
-    uint8_t *bufferPtr;                     // Pointer to work buffer
+} IDN_HEAD_ROUTE;
 
-    uint32_t startTime;                     // System time at stream start (log reference)
-    uint32_t frameCnt;                      // Number of sent frames
-    uint32_t frameTimestamp;                // Timestamp of the last frame
-    uint32_t cfgTimestamp;                  // Timestamp of the last channel configuration
 
-    // Buffer related
-    uint32_t payloadLen;                    // Currently used length of the buffer
+typedef struct
+{
+    IDN_SESSION *sessions;                  // One session per routed head
+    unsigned sessionCnt;                    // Number of routed heads
+    unsigned skipCnt;                       // Number of frames of other heads
+
+} IDN_HEAD_SELECT;
 
-    // IDN-Hello related
-    uint16_t sequence;                      // IDN-Hello sequence number (UDP packet tracking)
 
-    // IDN-Stream related
-    uint32_t sampleChunkHdrOffset;          // Offset of current sample chunk header 
-    uint32_t sampleCnt;                     // Current number of samples
+typedef struct
+{
+    char *filename;                         // IDTF file of the show
+    SHOW show;                              // Decoded frames
+    uint64_t mtimeNS;                       // Modification time of the decoded version
+    uint64_t size;                          // File size of the decoded version
+    int reloadFlag;                         // Changed on disk, reload pending
+    int loadFlag;                           // Not decoded yet (first decode pending or running)
 
-} IDNCONTEXT;
+} IDN_CUE;
+
+
+typedef struct
+{
+    int fd;                                 // Control connection, -1: unused
+    unsigned lineLen;                       // Number of bytes of the current command line
+    char line[MAX_SESSION_LINE];            // Current command line
+    IDN_CUE *waitCue;                       // Show loading, replied when decoded (load command), 0: none
+
+} IDN_CLIENT;
+
+
+typedef struct
+{
+    IDNCONTEXT ctx;                         // Stream to the target (kept open)
+    float xyScale;                          // Scale factor for decoding
+    unsigned options;                       // IDTF reader options
+
+    EVLOOP *evl;                            // Event loop (frames, keepalive, control connections)
+    EVLOOP_TIMER timer;                     // Next frame or keepalive
+    const char *socketPath;                 // Path of the control socket
+    int fdListen;                           // Control socket
+    IDN_CLIENT clients[MAX_DAEMON_CLIENTS];
+
+    IDN_CUE cues[MAX_DAEMON_CUES];          // Shows kept decoded
+    unsigned cueCnt;                        // Number of shows kept decoded
+    IDN_CUE *cue;                           // Show playing
+    unsigned frameIndex;                    // Next frame of the show
+    int playFlag;                           // Channel open, frames sent
+    int heldFlag;                           // Single-frame show sent, held until the next command
+    uint64_t dueTime;                       // Time of the next frame
+
+    int pendingOp;                          // Command to apply at the next frame boundary
+    IDN_CUE *pendingCue;                    // Show to play
+    unsigned pendingFrame;                  // Frame to continue with
+    uint64_t pendingTime;                   // Time the command was received (ns)
+    uint64_t latencyStart;                  // Command time to measure at the next frame sent, 0: none
+
+    uint32_t commandCnt;                    // Number of commands applied
+    uint32_t latencyCnt;                    // Number of latency measurements
+    uint64_t latencySum;                    // Sum of command-to-output latencies (ns)
+    uint64_t latencyMax;                    // Maximum command-to-output latency (ns)
+
+    int fdWatch;                            // File change notifications, -1: no hot reload
+    EVLOOP_TIMER decodeTimer;               // Show to load, changes settled or background decode to check
+    uint64_t settleTime;                    // Time the last changes settle
+    IDN_CUE *decodeCue;                     // Show loaded or reloaded in the background, 0: none
+    PLT_THREAD decodeThread;                // Background decoder
+    SHOW decodeShow;                        // Decoded frames (new version of the show)
+    uint64_t decodeMtime;                   // Modification time of the decoded version
+    uint64_t decodeSize;                    // File size of the decoded version
+    uint64_t decodeStart;                   // Time the decode started (ns)
+    int decodeRc;                           // Result of the background decoder
+    volatile uint32_t decodeDone;           // Background decoder finished
+    uint32_t reloadCnt;                     // Number of shows swapped
+    uint32_t rejectCnt;                     // Number of versions rejected (incomplete or rewritten)
+
+} IDN_DAEMON;
+
+
+typedef struct
+{
+    EVLOOP *evl;                            // Event loop of the shard
+    int fdSocket;                           // Socket of the shard
+    int cpu;                                // CPU core the shard thread is pinned to, -1: not pinned
+    int rtPriority;                         // SCHED_FIFO priority of the shard thread, 0: none
+    uint64_t load;                          // Estimated send load of all sessions on the shard
+    unsigned sessionCnt;                    // Number of sessions on the shard
+    PLT_THREAD thread;                      // Shard thread (several shards)
+    uint64_t cpuTime;                       // CPU time used by the event loop (ns)
+    int rc;                                 // Result of the event loop
+    IDN_SESSION *sessions;                  // All sessions (acknowledges passed to the ones of the shard)
+    unsigned allCnt;                        // Number of all sessions
+    unsigned activeCnt;                     // Sessions of the shard not done (the last one ends the watch)
+
+} IDN_SHARD;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Variables
+// -------------------------------------------------------------------------------------------------
+
+static SHAPER_LINK linkShaper;              // Uplink shared by all streams of the process
+static SCRIPT_CUES scriptCues;              // Cue names of the show scripts (one event loop)
 
 
 // -------------------------------------------------------------------------------------------------
 //  Tools
 // -------------------------------------------------------------------------------------------------
 
-void logError(const char *fmt, ...)
+static void logStdout(void *context, int level, const char *message)
 {
-    va_list arg_ptr;
-    va_start(arg_ptr, fmt);
-
-    //printf("\x1B[1;31m");
-    vprintf(fmt, arg_ptr);
-    //printf("\x1B[0m");
-    printf("\n");
+    // Player: Messages of the library and of the player itself on stdout
+    printf("%s\n", message);
     fflush(stdout);
 }
 
 
-void logInfo(const char *fmt, ...)
-{
-    va_list arg_ptr;
-    va_start(arg_ptr, fmt);
+// -------------------------------------------------------------------------------------------------
+//  Sender and decoder threads
+// -------------------------------------------------------------------------------------------------
 
-    vprintf(fmt, arg_ptr);
-    printf("\n");
-    fflush(stdout);
+static void prefaultStack()
+{
+    // Touch the stack ahead, so that deeper calls later on do not fault (pages stay locked)
+    volatile uint8_t stack[PREFAULT_STACK_SIZE];
+    for(unsigned i = 0; i < sizeof(stack); i += 0x1000) stack[i] = 0;
 }
 
 
-static int ensureBufferCapacity(IDNCONTEXT *ctx, unsigned minLen)
+static void setupRealtime(int rtCpu, int rtPriority, int mlockFlag)
 {
-    // Check for buffer enlargement
-    if(ctx->bufferLen < minLen)
+    // Note: Applies to the calling (sender) thread. Missing privileges are not fatal.
+    if(rtCpu >= 0)
     {
-        if(ctx->bufferLen == 0) ctx->bufferLen = minLen;
-        else while(ctx->bufferLen < minLen) ctx->bufferLen *= 2;
+        int rc = plt_threadSetAffinity(rtCpu);
+        if(rc) idnLogError("[IDN] Real-time: Pinning to CPU %d failed (error: %d), running unpinned", rtCpu, rc);
+        else idnLogInfo("[IDN] Real-time: Sender pinned to CPU %d", rtCpu);
+    }
 
-        ctx->bufferPtr = (uint8_t *)realloc(ctx->bufferPtr, ctx->bufferLen);
+    if(rtPriority > 0)
+    {
+        int rc = plt_threadSetRealtime(rtPriority);
+        if(rc) idnLogError("[IDN] Real-time: SCHED_FIFO priority %d not permitted (error: %d), running with normal priority", rtPriority, rc);
+        else idnLogInfo("[IDN] Real-time: Sender running SCHED_FIFO, priority %d", rtPriority);
     }
 
-    // Check buffer pointer
-    if(ctx->bufferPtr == (uint8_t *)0) 
-    { 
-        logError("[IDN] Insufficient buffer memory"); 
-        ctx->payloadLen = 0;
-        return -1; 
+    if(mlockFlag) prefaultStack();
+}
+
+
+static int idnReadPlaylist(DECODER_TASK *task)
+{
+    IDNCONTEXT *ctx = task->ctx;
+
+    // Decode the files back to back on the same channel. With the frame queue, the next file is
+    // opened and decoded while the queued frames of the previous one are still being sent.
+    for(unsigned i = 0; i < task->fileCnt; i++)
+    {
+        // Note: The first frame of a file within the playlist is kept, in case it is the only one
+        uint32_t decodeCnt = ctx->decodeCnt;
+        ctx->holdFrameFlag = (i + 1) < task->fileCnt;
+        int rc = idtfRead(task->filenames[i], task->xyScale, task->options, task->cbFunc, ctx);
+        ctx->holdFrameFlag = 0;
+        if(rc) return rc;
+
+        // Single-frame file within the playlist: Repeat the frame for the hold time (decoded once).
+        // The single frame file at the end of the playlist is held by the caller (keepalive, no
+        // new frames).
+        if((ctx->decodeCnt - decodeCnt) != 1 || (i + 1) == task->fileCnt) continue;
+        if(task->holdTime * ctx->frameRate > 1)
+        {
+            rc = idnRepeatFrame(ctx, task->holdTime * ctx->frameRate - 1);
+            if(rc) return rc;
+        }
     }
 
     return 0;
 }
 
 
-static char int2Hex(unsigned i)
+static PLT_THREAD_RESULT PLT_THREAD_CALL idnDecoderThread(void *arg)
 {
-    i &= 0xf;
-    return (char)((i > 9) ? ((i - 10) + 'A') : (i + '0'));
+    DECODER_TASK *task = (DECODER_TASK *)arg;
+
+    task->rc = idnReadPlaylist(task);
+
+    // End of stream (also on error), the sender drains the queue
+    frqClose(task->ctx->frameQueue);
+
+    return 0;
 }
 
 
-void binDump(void *buffer, unsigned length)
+// -------------------------------------------------------------------------------------------------
+//  Sessions
+// -------------------------------------------------------------------------------------------------
+
+static void idnSessionDone(IDN_SESSION *ssn)
 {
-    if(!length || !buffer) return;
+    // Note: The event loop runs while the socket is watched for acknowledges
+    ssn->doneFlag = 1;
+    if(ssn->activeCnt && !--*ssn->activeCnt) evlUnwatch(ssn->evl, ssn->ctx.fdSocket);
+}
 
-    char send[80];
-    char *dst1 = 0, *dst2 = 0;
-    char *src = (char *)buffer;
-    unsigned k = 0;
 
-    printf("dump buffer %08X; %d Bytes\n", (uint32_t)(uintptr_t)buffer, length);
+static void idnSessionTimer(void *context, uint64_t now)
+{
+    IDN_SESSION *ssn = (IDN_SESSION *)context;
+    IDNCONTEXT *ctx = &ssn->ctx;
 
-    while(k < length)
+    int rc = 0;
+    if(now < ssn->dueTime)
+    {
+        // Nothing sent for the keepalive interval
+        rc = idnSendVoid(ctx);
+    }
+    else if(ssn->frameIndex < ssn->show.frameCnt)
     {
-        if(!dst1)
+        // Frame due. Note: The deadline check handles late frames and returns the time to come back
+        // when the frame is held (shaper debt).
+        SHOW_FRAME *frame = &ssn->show.frames[ssn->frameIndex];
+        uint64_t deadline = 0;
+        int wait = idnWaitDeadline(ctx, &deadline);
+        if(wait == WAIT_DEADLINE_SEND) rc = idnSendShowFrame(ctx, frame, deadline);
+
+        // Same frame again, next frame, hold single-frame shows, close others right away
+        if(wait == WAIT_DEADLINE_EARLY)
+        {
+            ssn->dueTime = deadline;
+        }
+        else if(++ssn->frameIndex < ssn->show.frameCnt)
+        {
+            ssn->dueTime = idnFrameDeadline(ctx);
+        }
+        else if(ssn->show.frameCnt == 1)
+        {
+            ssn->dueTime = plt_getMonoTimeNS() + ((uint64_t)ssn->holdTime * 1000000000ull);
+        }
+        else
         {
-            memset(send, ' ', 80);
-            send[79] = 0;
+            ssn->dueTime = now;
+        }
+    }
+    else
+    {
+        // End of the show
+        idnSendClose(ctx);
+        idnSessionDone(ssn);
+        return;
+    }
 
-            send[0] = int2Hex((k >> 12) & 0x0f);
-            send[1] = int2Hex((k >> 8) & 0x0f);
-            send[2] = int2Hex((k >> 4) & 0x0f);
-            send[3] = int2Hex(k & 0x0f);
-            dst1 = &send[5];
-            dst2 = &send[57];
+    if(rc)
+    {
+        idnLogError("[SSN] %s: Send failed, session stopped", ssn->idtfFilename);
+        idnSessionDone(ssn);
+        return;
+    }
+
+    // Wake up for the next frame or when the channel would go quiet for too long
+    uint64_t wakeTime = ssn->dueTime;
+    if(ctx->keepaliveNS && (ctx->lastTxTime + ctx->keepaliveNS < wakeTime)) wakeTime = ctx->lastTxTime + ctx->keepaliveNS;
+    evlTimerArm(ssn->evl, &ssn->timer, wakeTime);
+}
+
+
+static void idnScriptWake(void *context)
+{
+    // Cue raised (by a script of the same event loop): Resume right away
+    IDN_SESSION *ssn = (IDN_SESSION *)context;
+    if(ssn->doneFlag) return;
+
+    ssn->cueFlag = 1;
+    evlTimerArm(ssn->evl, &ssn->timer, plt_getMonoTimeNS());
+}
+
+
+static int idnScriptFrame(IDN_SESSION *ssn, SHOW_FRAME *frame)
+{
+    // Send the frame when due, hold it otherwise (come back at the returned time)
+    IDNCONTEXT *ctx = &ssn->ctx;
+    uint64_t deadline = 0;
+    int wait = idnWaitDeadline(ctx, &deadline);
+    ssn->heldFrame = (wait == WAIT_DEADLINE_EARLY) ? frame : (SHOW_FRAME *)0;
+    ssn->dueTime = (wait == WAIT_DEADLINE_EARLY) ? deadline : idnFrameDeadline(ctx);
+
+    return (wait == WAIT_DEADLINE_SEND) ? idnSendShowFrame(ctx, frame, deadline) : 0;
+}
+
+
+static void idnScriptTimer(void *context, uint64_t now)
+{
+    IDN_SESSION *ssn = (IDN_SESSION *)context;
+    IDNCONTEXT *ctx = &ssn->ctx;
+    if(ssn->doneFlag) return;
+
+    int rc = 0;
+    int waitFlag = (ssn->scriptAct == SCRIPT_ACT_CUE) ? !ssn->cueFlag : (now < ssn->dueTime);
+    if(waitFlag)
+    {
+        // Waiting for a time or a cue: Nothing sent for the keepalive interval
+        if(ssn->playFlag) rc = idnSendVoid(ctx);
+    }
+    else if(ssn->heldFrame)
+    {
+        // Frame held back (shaper debt)
+        rc = idnScriptFrame(ssn, ssn->heldFrame);
+    }
+    else
+    {
+        // Resume the script up to the next thing to wait for
+        SCRIPT_AWAIT await;
+        int prevAct = ssn->scriptAct;
+        ssn->cueFlag = 0;
+        while(((ssn->scriptAct = scrResume(&ssn->run, now, &await)) == SCRIPT_ACT_STOP) && !rc)
+        {
+            if(ssn->playFlag) rc = idnSendChannelClose(ctx);
+            ssn->playFlag = 0;
         }
 
-        unsigned char c = *src++;
-        *dst1++ = int2Hex(c >> 4);
-        *dst1++ = int2Hex(c);
-        *dst1++ = ' ';
-        if((k % 16) == 7)
-        {*dst1++ = ' '; *dst1++ = ' ';}
-        if(c < 0x20) c = '.';
-        if(c > 0x7F) c = '.';
-        *dst2++ = c;
+        if(ssn->scriptAct == SCRIPT_ACT_FRAME)
+        {
+            // Note: After a pause (channel closed or no frames meanwhile), start a new schedule
+            if(((prevAct != SCRIPT_ACT_FRAME) || !ssn->playFlag) && !ctx->timeline)
+            {
+                ctx->scheduleIndex = 0;
+                ctx->lastSendTime = 0;
+            }
+            ssn->playFlag = 1;
 
-        if((k % 16) == 15)
+            if(!rc) rc = idnScriptFrame(ssn, &ssn->scriptShows[await.fileIndex].frames[await.frameIndex]);
+        }
+        else if(ssn->scriptAct == SCRIPT_ACT_WAIT)
+        {
+            ssn->dueTime = await.time;
+        }
+        else if(ssn->scriptAct == SCRIPT_ACT_CUE)
+        {
+            ssn->dueTime = UINT64_MAX;
+        }
+        else if(!rc)
         {
-            *dst2++ = 0;
-            printf("%s\n", send);
-            dst1 = 0;
-            dst2 = 0;
+            // End of the script
+            idnSendClose(ctx);
+            idnSessionDone(ssn);
+            return;
         }
-        k++;
     }
 
-    if(k % 16) printf("%s\n", send);
+    if(rc)
+    {
+        idnLogError("[SSN] %s: Send failed, session stopped", ssn->scriptFilename);
+        idnSessionDone(ssn);
+        return;
+    }
 
-    fflush(stdout);
+    // Wake up for the next frame, the end of a wait or when the channel would go quiet for too long
+    uint64_t wakeTime = ssn->dueTime;
+    if(ssn->playFlag && ctx->keepaliveNS && (ctx->lastTxTime + ctx->keepaliveNS < wakeTime)) wakeTime = ctx->lastTxTime + ctx->keepaliveNS;
+    if(wakeTime != UINT64_MAX) evlTimerArm(ssn->evl, &ssn->timer, wakeTime);
 }
 
 
-static int idnSend(void *context, IDNHDR_PACKET *packetHdr, unsigned packetLen)
+static int idnLoadScript(IDN_SESSION *ssn)
 {
-    IDNCONTEXT *ctx = (IDNCONTEXT *)context;
+    // Own copy of the script file name, statements parsed upfront (files decoded with the sessions)
+    ssn->scriptFilename = strdup(ssn->scriptFilename);
+    if(!ssn->scriptFilename) return -1;
+    if(scrLoad(ssn->scriptFilename, &scriptCues, &ssn->script))
+    {
+        free(ssn->scriptFilename);
+        ssn->scriptFilename = (char *)0;
+        return -1;
+    }
+
+    return 0;
+}
 
-/*
-    printf("\n%u\n", (plt_getMonoTimeUS() - ctx->startTime) / 1000);
-    binDump(packetHdr, packetLen);
-*/
 
-    if(sendto(ctx->fdSocket, (const char *)packetHdr, packetLen, 0, (struct sockaddr *)&ctx->serverSockAddr, sizeof(ctx->serverSockAddr)) < 0)
+static int idnParseSession(IDN_SESSION *ssn, char *line)
+{
+    // Split into options (as on the command line). Note: No quoting, file names without blanks.
+    char *argv[MAX_SESSION_ARGS];
+    int argc = 0;
+    for(char *token = strtok(line, " \t\r\n"); token; token = strtok((char *)0, " \t\r\n"))
     {
-        logError("sendto() failed (error: %d)", plt_sockGetLastError());
-        return -1;
+        if(argc == MAX_SESSION_ARGS) return -1;
+        argv[argc++] = token;
     }
 
+    IDNCONTEXT *ctx = &ssn->ctx;
+    char *idtfFilename = (char *)0, *scriptFilename = (char *)0;
+    for(int i = 0; i < argc; i++)
+    {
+        int param = ((i + 1) < argc) ? atoi(argv[i + 1]) : 0;
+
+        if(!strcmp(argv[i], "-hs") && (++i < argc))
+        {
+            ctx->serverSockAddr.sin_addr.s_addr = inet_addr(argv[i]);
+        }
+        else if(!strcmp(argv[i], "-cg") && (++i < argc) && (param >= 0) && (param < 16))
+        {
+            ctx->clientGroup = (unsigned char)param;
+        }
+        else if(!strcmp(argv[i], "-sid") && (++i < argc) && (param >= 0) && (param < 256))
+        {
+            ctx->serviceID = (unsigned char)param;
+        }
+        else if(!strcmp(argv[i], "-idtf") && (++i < argc))
+        {
+            idtfFilename = argv[i];
+        }
+        else if(!strcmp(argv[i], "-script") && (++i < argc))
+        {
+            scriptFilename = argv[i];
+        }
+        else if(!strcmp(argv[i], "-hold") && (++i < argc) && (param > 0))
+        {
+            ssn->holdTime = param;
+        }
+        else if(!strcmp(argv[i], "-fr") && (++i < argc) && (param >= 5))
+        {
+            ctx->frameRate = param;
+            ctx->usFrameTime = 1000000 / param;
+        }
+        else if(!strcmp(argv[i], "-pps") && (++i < argc) && (param > 0))
+        {
+            ctx->scanSpeed = param;
+        }
+        else if(!strcmp(argv[i], "-sft") && (++i < argc) && (param >= 0))
+        {
+            // Note: Applied by the frame processing if enabled
+            if(ctx->resampleFlag || ctx->budgetFlag) ctx->processShift = param;
+            else ctx->colorShift = param;
+        }
+        else if(!strcmp(argv[i], "-scale") && (++i < argc))
+        {
+            ssn->xyScale = (float)atof(argv[i]);
+        }
+        else if(!strcmp(argv[i], "-mx"))
+        {
+            ssn->options |= IDTFOPT_MIRROR_X;
+        }
+        else if(!strcmp(argv[i], "-my"))
+        {
+            ssn->options |= IDTFOPT_MIRROR_Y;
+        }
+        else
+        {
+            return -1;
+        }
+    }
+
+    // IDTF file or show script of the line, otherwise from the command line (script first)
+    if(idtfFilename && scriptFilename) return -1;
+    if(idtfFilename) ssn->scriptFilename = (char *)0;
+    if(scriptFilename) ssn->scriptFilename = scriptFilename;
+    if(ssn->scriptFilename) ssn->idtfFilename = (char *)0;
+    else if(idtfFilename) ssn->idtfFilename = idtfFilename;
+
+    // Own copy of the file name (the line buffer is reused)
+    if((!ssn->idtfFilename && !ssn->scriptFilename) || !ctx->serverSockAddr.sin_addr.s_addr) return -1;
+    if(ssn->scriptFilename) return idnLoadScript(ssn);
+    ssn->idtfFilename = strdup(ssn->idtfFilename);
+    if(!ssn->idtfFilename) return -1;
+
     return 0;
 }
 
 
-// -------------------------------------------------------------------------------------------------
-//  IDN
-// -------------------------------------------------------------------------------------------------
+static IDN_SESSION *idnLoadSessions(char *sessionsFilename, IDN_SESSION *tmpl, unsigned *sessionCntPtr)
+{
+    FILE *fp = plt_fopen(sessionsFilename, "r");
+    if(!fp)
+    {
+        idnLogError("[SSN] Cannot open %s", sessionsFilename);
+        return (IDN_SESSION *)0;
+    }
+
+    IDN_SESSION *sessions = (IDN_SESSION *)0;
+    unsigned sessionCnt = 0, sessionCap = 0, lineNumber = 0;
+    char line[MAX_SESSION_LINE];
+    int rc = 0;
+    while(fgets(line, sizeof(line), fp))
+    {
+        // Skip empty lines and comments
+        lineNumber++;
+        char *linePtr = line;
+        while((*linePtr == ' ') || (*linePtr == '\t')) linePtr++;
+        if((*linePtr == '#') || (*linePtr == '\r') || (*linePtr == '\n') || (*linePtr == 0)) continue;
+
+        if(sessionCnt == sessionCap)
+        {
+            sessionCap = sessionCap ? 2 * sessionCap : 16;
+            IDN_SESSION *resized = (IDN_SESSION *)realloc(sessions, sessionCap * sizeof(IDN_SESSION));
+            if(!resized) { idnLogError("[SSN] Insufficient session memory"); rc = -1; break; }
+            sessions = resized;
+        }
+
+        // Settings from the command line, overridden by the options of the line
+        IDN_SESSION *ssn = &sessions[sessionCnt];
+        memcpy(ssn, tmpl, sizeof(IDN_SESSION));
+        if(idnParseSession(ssn, linePtr))
+        {
+            idnLogError("[SSN] %s, line %u: Invalid session (need -hs and -idtf or -script, options -cg, -sid, -fr, -pps, -sft, -hold, -scale, -mx, -my)",
+                        sessionsFilename, lineNumber);
+            rc = -1;
+            break;
+        }
+        sessionCnt++;
+    }
+    fclose(fp);
+
+    if(!rc && !sessionCnt) { idnLogError("[SSN] %s: No sessions", sessionsFilename); rc = -1; }
+    if(rc)
+    {
+        for(unsigned i = 0; i < sessionCnt; i++)
+        {
+            if(sessions[i].idtfFilename) free(sessions[i].idtfFilename);
+            if(sessions[i].scriptFilename) free(sessions[i].scriptFilename);
+            scrFree(&sessions[i].script);
+        }
+        if(sessions) free(sessions);
+        return (IDN_SESSION *)0;
+    }
 
-int idnOpenFrameXYRGB(void *context)
+    *sessionCntPtr = sessionCnt;
+    return sessions;
+}
+
+
+static IDN_SESSION *idnLoadHeads(IDN_HEAD_ROUTE *routes, unsigned routeCnt, IDN_SESSION *tmpl)
 {
-    IDNCONTEXT *ctx = (IDNCONTEXT *)context;
+    // One session per head, settings from the command line
+    IDN_SESSION *sessions = (IDN_SESSION *)calloc(routeCnt, sizeof(IDN_SESSION));
+    if(!sessions) { idnLogError("[SSN] Insufficient session memory"); return (IDN_SESSION *)0; }
 
-    // Sanity check (buffer already in use?)
-    if(ctx->payloadLen != 0) return -1;
+    int rc = 0;
+    for(unsigned i = 0; i < routeCnt; i++)
+    {
+        IDN_SESSION *ssn = &sessions[i];
+        memcpy(ssn, tmpl, sizeof(IDN_SESSION));
+        ssn->headNumber = routes[i].headNumber;
+        ssn->ctx.serverSockAddr.sin_addr.s_addr = routes[i].serverAddr;
+        if(routes[i].serviceID >= 0) ssn->ctx.serviceID = (unsigned char)routes[i].serviceID;
+        ssn->idtfFilename = strdup(tmpl->idtfFilename);
+        if(!ssn->idtfFilename) { idnLogError("[SSN] Insufficient session memory"); rc = -1; break; }
+
+        for(unsigned k = 0; k < i; k++)
+        {
+            if(sessions[k].headNumber != ssn->headNumber) continue;
 
-    // Make sure there is enough buffer
-    if(ensureBufferCapacity(ctx, 0x4000)) return -1;
+            idnLogError("[SSN] Head %d routed twice", ssn->headNumber);
+            rc = -1;
+        }
+        if(rc) break;
+    }
 
-    // IDN-Hello packet header. Note: Sequence number populated on push
-    IDNHDR_PACKET *packetHdr = (IDNHDR_PACKET *)ctx->bufferPtr;
-    packetHdr->command = IDNCMD_RT_CNLMSG;
-    packetHdr->flags = ctx->clientGroup;
+    if(rc)
+    {
+        for(unsigned i = 0; i < routeCnt; i++) if(sessions[i].idtfFilename) free(sessions[i].idtfFilename);
+        free(sessions);
+        return (IDN_SESSION *)0;
+    }
 
-    // ---------------------------------------------------------------------------------------------
+    return sessions;
+}
 
-    // IDN-Stream channel message header. Note: Remaining fields populated on push
-    IDNHDR_CHANNEL_MESSAGE *channelMsgHdr = (IDNHDR_CHANNEL_MESSAGE *)&packetHdr[1];
-    uint16_t contentID = IDNFLG_CONTENTID_CHANNELMSG;
-    
-    // Insert channel config header every 200 ms
-    unsigned now = plt_getMonoTimeUS();
-    IDNHDR_SAMPLE_CHUNK *sampleChunkHdr = (IDNHDR_SAMPLE_CHUNK *)&channelMsgHdr[1];
-    if((ctx->frameCnt == 0) || ((now - ctx->cfgTimestamp) > 200000))
-    {
-        // IDN-Stream channel configuration header
-        IDNHDR_CHANNEL_CONFIG *channelConfigHdr = (IDNHDR_CHANNEL_CONFIG *)sampleChunkHdr;
-        channelConfigHdr->wordCount = 4;
-        channelConfigHdr->flags = IDNFLG_CHNCFG_ROUTING;
-        channelConfigHdr->serviceID = ctx->serviceID;
-        channelConfigHdr->serviceMode = IDNVAL_SMOD_LPGRF_DISCRETE;
-
-        // Standard IDTF-to-IDN descriptors
-        uint16_t *descriptors = (uint16_t *)&channelConfigHdr[1];
-        descriptors[0] = htons(0x4200);     // X
-        descriptors[1] = htons(0x4010);     // 16 bit precision
-        descriptors[2] = htons(0x4210);     // Y
-        descriptors[3] = htons(0x4010);     // 16 bit precision
-        descriptors[4] = htons(0x527E);     // Red, 638 nm
-        descriptors[5] = htons(0x5214);     // Green, 532 nm
-        descriptors[6] = htons(0x51CC);     // Blue, 460 nm
-        descriptors[7] = htons(0x0000);     // Void for alignment
-
-        // Move sample chunk start and set flag in contentID field
-        sampleChunkHdr = (IDNHDR_SAMPLE_CHUNK *)&descriptors[8];
-        contentID |= IDNFLG_CONTENTID_CONFIG_LSTFRG;
-    }
-    channelMsgHdr->contentID = htons(contentID);
-
-    // ---------------------------------------------------------------------------------------------
-
-    // Setup for sample chunk data positions
-    ctx->sampleChunkHdrOffset = (uint8_t *)sampleChunkHdr - ctx->bufferPtr;
-    ctx->payloadLen = (uint8_t *)&sampleChunkHdr[1] - ctx->bufferPtr;
-    ctx->sampleCnt = 0;
+
+static IDN_SESSION *idnLoadScriptSession(IDN_SESSION *tmpl, unsigned *sessionCntPtr)
+{
+    // One session, settings from the command line
+    IDN_SESSION *ssn = (IDN_SESSION *)malloc(sizeof(IDN_SESSION));
+    if(!ssn) { idnLogError("[SSN] Insufficient session memory"); return (IDN_SESSION *)0; }
+
+    memcpy(ssn, tmpl, sizeof(IDN_SESSION));
+    ssn->idtfFilename = (char *)0;
+    if(idnLoadScript(ssn)) { free(ssn); return (IDN_SESSION *)0; }
+
+    *sessionCntPtr = 1;
+    return ssn;
+}
+
+
+static int idnConnectSessions(IDN_SESSION *sessions, unsigned sessionCnt)
+{
+    // Sessions to the same server are channels of one IDN-Hello session (common sequence, socket)
+    for(unsigned i = 0; i < sessionCnt; i++)
+    {
+        IDN_SESSION *ssn = &sessions[i];
+        IDNCONTEXT *ctx = &ssn->ctx;
+
+        IDN_SESSION *first = ssn;
+        for(unsigned k = 0; k < i; k++)
+        {
+            if(sessions[k].ctx.serverSockAddr.sin_addr.s_addr != ctx->serverSockAddr.sin_addr.s_addr) continue;
+            if(first == ssn) first = &sessions[k];
+
+            // Note: The server routes the channels by service ID
+            if(sessions[k].ctx.serviceID == ctx->serviceID)
+            {
+                idnLogError("[SSN] Session %u: Service ID %u of %s already used by session %u", i + 1, ctx->serviceID,
+                            inet_ntoa(ctx->serverSockAddr.sin_addr), k + 1);
+                return -1;
+            }
+        }
+
+        IDN_CONNECTION *connection = &first->connection;
+        if(first != ssn)
+        {
+            if(first->ctx.clientGroup != ctx->clientGroup)
+            {
+                idnLogError("[SSN] Session %u: Client group differs from session %u (same server)", i + 1, (unsigned)(first - sessions) + 1);
+                return -1;
+            }
+            if(connection->channelCnt == IDNVAL_CHANNEL_COUNT)
+            {
+                idnLogError("[SSN] Session %u: More than %u channels to %s", i + 1, IDNVAL_CHANNEL_COUNT,
+                            inet_ntoa(ctx->serverSockAddr.sin_addr));
+                return -1;
+            }
+        }
+
+        ctx->connection = connection;
+        ctx->channelID = (uint8_t)connection->channelCnt++;
+        connection->openCnt++;
+    }
 
     return 0;
 }
 
 
-int idnPutSampleXYRGB(void *context, int16_t x, int16_t y, uint8_t r, uint8_t g, uint8_t b)
+static uint64_t idnShowLoad(SHOW *show, unsigned frameRate)
 {
-    IDNCONTEXT *ctx = (IDNCONTEXT *)context;
+    // Estimated send load: Bytes per second plus a fixed cost per frame
+    uint64_t byteCnt = 0;
+    for(unsigned i = 0; i < show->frameCnt; i++) byteCnt += show->frames[i].dataLen + SESSION_FRAME_COST;
+    return show->frameCnt ? (byteCnt * frameRate) / show->frameCnt : 0;
+}
+
 
-    // Sanity check (sample chunk bracket open?)
-    if(ctx->payloadLen == 0) return -1;
+static void idnEstimateLoad(IDN_SESSION *ssn)
+{
+    // Note: Scripts play one file at a time, the heaviest one counts
+    ssn->load = idnShowLoad(&ssn->show, ssn->ctx.frameRate);
+    for(unsigned i = 0; ssn->scriptShows && (i < ssn->script.fileCnt); i++)
+    {
+        uint64_t load = idnShowLoad(&ssn->scriptShows[i], ssn->ctx.frameRate);
+        if(load > ssn->load) ssn->load = load;
+    }
+}
 
-    // Make sure there is enough buffer.
-    unsigned lenNeeded = ctx->payloadLen + ((1 + ctx->colorShift) * XYRGB_SAMPLE_SIZE);
-    if(ensureBufferCapacity(ctx, lenNeeded)) return -1;
 
+static int idnDecodeScript(IDN_SESSION *ssn, IDTF_CALLBACK_FUNC *cbFunc)
+{
+    // Decode the files of the script, each one once
+    IDNCONTEXT *ctx = &ssn->ctx;
+    ssn->scriptShows = (SHOW *)calloc(ssn->script.fileCnt, sizeof(SHOW));
+    if(!ssn->scriptShows) { idnLogError("[SSN] Insufficient show memory"); return -1; }
+
+    scrInitRun(&ssn->run, &ssn->script, &scriptCues, (uint64_t)ssn->holdTime * 1000000000ull);
+    ssn->run.wakeFunc = idnScriptWake;
+    ssn->run.wakeContext = ssn;
+    for(unsigned i = 0; i < ssn->script.fileCnt; i++)
+    {
+        ctx->show = &ssn->scriptShows[i];
+        if(idtfRead(ssn->script.files[i], ssn->xyScale, ssn->options, cbFunc, ctx)) return -1;
+        if(!ssn->scriptShows[i].frameCnt) { idnLogError("[SSN] %s: No frames", ssn->script.files[i]); return -1; }
+        ssn->run.frameCnts[i] = ssn->scriptShows[i].frameCnt;
+    }
 
-    // Note: With IDN, the first two points and the last two points of a frame have special 
-    // meanings, The first point is the start point and shall be invisible (not part of the frame, 
-    // not taken into account with duration calculations) and is used to move the draw cursor 
-    // only. This is because a shape of n points has n-1 connecting segments (with associated time
-    // and color). The shape is closed when last point and first point are equal and the shape is
-    // continuous when first segment and last segment are continuous. Hidden lines or bends shall 
-    // be inserted on the fly in case of differing start point and end point or discontinuity.
+    return 0;
+}
 
 
-    // Get pointer to next sample
-    uint8_t *p = &ctx->bufferPtr[ctx->payloadLen];
+static void idnDecodeSession(void *context)
+{
+    // Decode the show (work pool job). Note: Runs on any thread, touches the session only.
+    IDN_SESSION *ssn = (IDN_SESSION *)context;
+    IDNCONTEXT *ctx = &ssn->ctx;
 
-    // Store galvo sample bytes
-    *p++ = (uint8_t)(x >> 8);
-    *p++ = (uint8_t)x;
-    *p++ = (uint8_t)(y >> 8);
-    *p++ = (uint8_t)y;
+    IDTF_CALLBACK_FUNC cbFunc = { 0 };
+    cbFunc.openFrame = idnOpenFrameXYRGB;
+    cbFunc.putSampleXYRGB = idnPutSampleXYRGB;
+    cbFunc.pushFrame = idnPushFrameXYRGB;
 
-    // Check for color shift init
-    if(ctx->sampleCnt == 0) 
+    if(ssn->scriptFilename)
     {
-        // Color shift samples
-        for(unsigned i = 0; i < ctx->colorShift; i++) 
-        {
-            p[0] = 0;
-            p[1] = 0;
-            p[2] = 0;
-            p += XYRGB_SAMPLE_SIZE;
-        }
+        ssn->decodeRc = idnDecodeScript(ssn, &cbFunc);
     }
     else
     {
-        // Other samples - just move the pointer
-        p += XYRGB_SAMPLE_SIZE * ctx->colorShift;
+        ctx->show = &ssn->show;
+        ssn->decodeRc = idtfRead(ssn->idtfFilename, ssn->xyScale, ssn->options, &cbFunc, ctx);
     }
+    ctx->show = (SHOW *)0;
+    frmFree(&ctx->processSource);
+    frmFree(&ctx->processTarget);
 
-    // Store color sample bytes
-    *p++ = r;
-    *p++ = g;
-    *p++ = b;
+    idnEstimateLoad(ssn);
+}
 
-    // Update payload length to include the sample, update sample count
-    ctx->payloadLen += XYRGB_SAMPLE_SIZE;
-    ctx->sampleCnt++;
 
-    return 0;
+static void *idnSelectHead(void *context, uint8_t headNumber)
+{
+    // Route the frames of a head to its session, skip other heads
+    IDN_HEAD_SELECT *select = (IDN_HEAD_SELECT *)context;
+    for(unsigned i = 0; i < select->sessionCnt; i++)
+    {
+        if(select->sessions[i].headNumber == headNumber) return &select->sessions[i].ctx;
+    }
+
+    select->skipCnt++;
+    return (void *)0;
 }
 
 
-int idnPushFrameXYRGB(void *context)
+static int idnDecodeHeads(IDN_SESSION *sessions, unsigned sessionCnt)
 {
-    IDNCONTEXT *ctx = (IDNCONTEXT *)context;
+    // Decode the file once, the frames of each head go to the show of its session
+    IDTF_CALLBACK_FUNC cbFunc = { 0 };
+    cbFunc.openFrame = idnOpenFrameXYRGB;
+    cbFunc.putSampleXYRGB = idnPutSampleXYRGB;
+    cbFunc.pushFrame = idnPushFrameXYRGB;
+    cbFunc.selectHead = idnSelectHead;
+
+    IDN_HEAD_SELECT select = { sessions, sessionCnt, 0 };
+    for(unsigned i = 0; i < sessionCnt; i++) sessions[i].ctx.show = &sessions[i].show;
+    int rc = idtfRead(sessions[0].idtfFilename, sessions[0].xyScale, sessions[0].options, &cbFunc, &select);
+
+    for(unsigned i = 0; i < sessionCnt; i++)
+    {
+        IDN_SESSION *ssn = &sessions[i];
+        ssn->ctx.show = (SHOW *)0;
+        frmFree(&ssn->ctx.processSource);
+        frmFree(&ssn->ctx.processTarget);
+        idnEstimateLoad(ssn);
+
+        idnLogInfo("[SSN] Head %d: %u frames to %s, service ID %u", ssn->headNumber, ssn->show.frameCnt,
+                   inet_ntoa(ssn->ctx.serverSockAddr.sin_addr), ssn->ctx.serviceID);
+    }
+    if(select.skipCnt) idnLogInfo("[SSN] %u frames of other heads skipped", select.skipCnt);
 
-    // Sanity check (sample chunk bracket open?)
-    if(ctx->payloadLen == 0) return -1;
-    if(ctx->sampleCnt < 2) { logError("[IDN] Invalid sample count %u", ctx->sampleCnt); return -1; }
+    return rc;
+}
 
-    // ---------------------------------------------------------------------------------------------
 
-    // Duplicate last position for color shift samples
-    for(unsigned i = 0; i < ctx->colorShift; i++) 
+static int idnDecodeSessions(IDN_SESSION *sessions, unsigned sessionCnt, unsigned workerCnt)
+{
+    // Decode the shows. Several workers: In parallel, idle workers take jobs of busy ones (dense shows)
+    WORKPOOL *wkp = (workerCnt > 1) ? wkpCreate(workerCnt) : (WORKPOOL *)0;
+    for(unsigned i = 0; i < sessionCnt; i++)
     {
-        // Get pointer to last position and next sample (already has color due to shift)
-        uint16_t *src = (uint16_t *)&ctx->bufferPtr[ctx->payloadLen - XYRGB_SAMPLE_SIZE];
-        uint16_t *dst = (uint16_t *)&ctx->bufferPtr[ctx->payloadLen];
+        if(!wkp || wkpSubmit(wkp, idnDecodeSession, &sessions[i])) idnDecodeSession(&sessions[i]);
+    }
+    if(wkp)
+    {
+        WORKPOOL_STATS stats;
+        wkpWait(wkp);
+        wkpGetStats(wkp, &stats);
+        wkpDestroy(wkp);
+        idnLogInfo("[SSN] Decoding: %u workers, %llu jobs (%llu..%llu per worker), %llu stolen",
+                   stats.workerCnt, (unsigned long long)stats.jobCnt, (unsigned long long)stats.jobMin,
+                   (unsigned long long)stats.jobMax, (unsigned long long)stats.stealCnt);
+    }
 
-        // Duplicate position samples (X/Y)
-        *dst++ = *src++;
-        *dst++ = *src++;
+    for(unsigned i = 0; i < sessionCnt; i++) if(sessions[i].decodeRc) return -1;
+    return 0;
+}
 
-        // Update pointer to next sample, update sample count
-        ctx->payloadLen += XYRGB_SAMPLE_SIZE;
-        ctx->sampleCnt++;
+
+static void idnFreeSessions(IDN_SESSION *sessions, unsigned sessionCnt)
+{
+    for(unsigned i = 0; i < sessionCnt; i++)
+    {
+        IDN_SESSION *ssn = &sessions[i];
+        if(ssn->evl) evlTimerCancel(ssn->evl, &ssn->timer);
+        shpDetachStream(&ssn->ctx.shaper);
+        idnShowFree(&ssn->show);
+        if(ssn->ctx.bufferPtr) free(ssn->ctx.bufferPtr);
+        if(ssn->idtfFilename) free(ssn->idtfFilename);
+        if(ssn->scriptFilename)
+        {
+            for(unsigned k = 0; ssn->scriptShows && (k < ssn->script.fileCnt); k++) idnShowFree(&ssn->scriptShows[k]);
+            if(ssn->scriptShows) free(ssn->scriptShows);
+            scrFree(&ssn->script);
+            free(ssn->scriptFilename);
+        }
     }
+    free(sessions);
+}
+
+
+static int compareSessionLoad(const void *a, const void *b)
+{
+    // Heaviest connection first, channels of a connection together
+    const IDN_CONNECTION *ca = (*(IDN_SESSION * const *)a)->ctx.connection;
+    const IDN_CONNECTION *cb = (*(IDN_SESSION * const *)b)->ctx.connection;
+    if(ca->load != cb->load) return (ca->load < cb->load) ? 1 : -1;
+    return (ca < cb) ? -1 : ((ca > cb) ? 1 : 0);
+}
+
 
-    // Sample chunk header: Calculate frame duration based on scan speed.
-    // In case jitter-free option is set: Scan frames (starting from second) ony once.
-    IDNHDR_SAMPLE_CHUNK *sampleChunkHdr = (IDNHDR_SAMPLE_CHUNK *)&ctx->bufferPtr[ctx->sampleChunkHdrOffset];
-    uint32_t frameDuration = (((uint64_t)(ctx->sampleCnt - 1)) * 1000000ull) / (uint64_t)ctx->scanSpeed;
-    uint8_t frameFlags = 0;
-    if(ctx->jitterFreeFlag && ctx->frameCnt != 0) frameFlags |= IDNFLG_GRAPHIC_FRAME_ONCE;
-    sampleChunkHdr->flagsDuration = htonl((frameFlags << 24) | frameDuration);
+static PLT_THREAD_RESULT PLT_THREAD_CALL idnShardThread(void *arg)
+{
+    IDN_SHARD *shard = (IDN_SHARD *)arg;
+
+    setupRealtime(shard->cpu, shard->rtPriority, 0);
+
+    uint64_t cpuStart = plt_readThreadCPUTimeNS();
+    shard->rc = evlRun(shard->evl);
+    shard->cpuTime = plt_readThreadCPUTimeNS() - cpuStart;
+
+    return 0;
+}
 
-    // Wait between frames to match frame rate
-    if(ctx->frameCnt != 0)
+
+static void idnShardAckRead(void *context, int fd)
+{
+    // Datagrams on the socket of the shard: Acknowledges, passed to the sessions of the sender
+    IDN_SHARD *shard = (IDN_SHARD *)context;
+    uint8_t buffer[64];
+    struct sockaddr_in fromAddr;
+    int length;
+    while((length = plt_sockRecvFromNow(fd, buffer, sizeof(buffer), &fromAddr)) > 0)
     {
-        unsigned usWait = ctx->usFrameTime - (plt_getMonoTimeUS() - ctx->frameTimestamp);
-        if((int)usWait > 0) plt_usleep(usWait);
+        uint64_t now = plt_getMonoTimeNS();
+        for(unsigned i = 0; i < shard->allCnt; i++)
+        {
+            IDN_SESSION *ssn = &shard->sessions[i];
+            if(ssn->evl != shard->evl) continue;
+            if(ssn->ctx.serverSockAddr.sin_addr.s_addr != fromAddr.sin_addr.s_addr) continue;
+            if(idnReceiveAck(&ssn->ctx, buffer, (unsigned)length, now)) break;
+        }
     }
-    ctx->frameCnt++;
+}
 
-    // ---------------------------------------------------------------------------------------------
 
-    // Calculate header pointers, get message contentID (because of byte order)
-    IDNHDR_PACKET *packetHdr = (IDNHDR_PACKET *)ctx->bufferPtr;
-    IDNHDR_CHANNEL_MESSAGE *channelMsgHdr = (IDNHDR_CHANNEL_MESSAGE *)&packetHdr[1];
-    uint16_t contentID = ntohs(channelMsgHdr->contentID);
+static int idnRunSessions(IDN_SESSION *sessions, unsigned sessionCnt, IDN_SESSION *tmpl, unsigned shardCnt,
+                          int rtCpu, int rtPriority)
+{
+    // Drive the sessions from one event loop thread per shard: Shows decoded upfront, frames
+    // sent on timers. Each session stays on its shard (frames in order, one socket per shard).
+    // Note: Takes the sessions (freed on return).
+    if(shardCnt > sessionCnt) shardCnt = sessionCnt;
+    if(scriptCues.cueCnt && (shardCnt > 1))
+    {
+        idnLogError("[SSN] Show scripts with cues run on one event loop, -shards ignored");
+        shardCnt = 1;
+    }
+    IDN_SHARD *shards = (IDN_SHARD *)calloc(shardCnt, sizeof(IDN_SHARD));
+    IDN_SESSION **order = (IDN_SESSION **)calloc(sessionCnt, sizeof(IDN_SESSION *));
 
-    // IDN channel message header: Set timestamp; Update internal timestamps.
-    unsigned now = plt_getMonoTimeUS();
-    channelMsgHdr->timestamp = htonl(now);
-    ctx->frameTimestamp = now;
-    if(contentID & IDNFLG_CONTENTID_CONFIG_LSTFRG) ctx->cfgTimestamp = now;
+    int rc = 0;
+    for(unsigned i = 0; shards && (i < shardCnt); i++)
+    {
+        // Own event loop and socket per shard, pinned to consecutive cores (several shards)
+        IDN_SHARD *shard = &shards[i];
+        shard->evl = evlCreate();
+        shard->fdSocket = (i == 0) ? tmpl->ctx.fdSocket : plt_sockOpen(AF_INET, SOCK_DGRAM, 0);
+        shard->cpu = (shardCnt == 1) ? -1 : (((rtCpu < 0) ? 0 : rtCpu) + i) % plt_getCPUCount();
+        shard->rtPriority = (shardCnt == 1) ? 0 : rtPriority;
+        if(!shard->evl || (shard->fdSocket < 0)) rc = -1;
+    }
+    if(!shards || !order || rc)
+    {
+        idnLogError("[SSN] Shard setup failed");
+        rc = -1;
+    }
 
-    // Message header: Calculate message length. Must not exceed 0xFF00 octets !!
-    // Note: Pointer type uint8_t and substraction is defined as the difference of (array) elements.
-    uint8_t *payloadLimit = &ctx->bufferPtr[ctx->payloadLen];
-    unsigned msgLength = payloadLimit - (uint8_t *)channelMsgHdr;
-    if(msgLength > MAX_IDN_MESSAGE_LEN)
+    // Own traffic shaping bucket on the shared link per session
+    uint64_t sampleCnt = 0;
+    for(unsigned i = 0; i < sessionCnt; i++) shpCloneStream(&sessions[i].ctx.shaper, &tmpl->ctx.shaper);
+
+    // Spread the connections over the shards: Heaviest first, each one to the least loaded shard.
+    // Note: The channels of a connection share the sequence and the socket (same shard). The placement
+    // is static, the work pool only decodes the shows up front (no per-frame stealing during playback).
+    for(unsigned i = 0; !rc && (i < sessionCnt); i++)
     {
-        // Fragmented frame (split across multiple messages), set message length and chunk type
-        channelMsgHdr->totalSize = htons(MAX_IDN_MESSAGE_LEN);
-        channelMsgHdr->contentID = htons(contentID | IDNVAL_CNKTYPE_LPGRF_FRAME_FIRST);
-        uint8_t *splitPtr = (uint8_t *)channelMsgHdr + MAX_IDN_MESSAGE_LEN;
+        sampleCnt += sessions[i].ctx.decodeSampleCnt;
+        sessions[i].ctx.connection->load += sessions[i].load;
+        order[i] = &sessions[i];
+    }
+    if(!rc) qsort(order, sessionCnt, sizeof(IDN_SESSION *), compareSessionLoad);
+    for(unsigned i = 0; !rc && (i < sessionCnt); i++)
+    {
+        IDN_SESSION *ssn = order[i];
+        IDN_CONNECTION *connection = ssn->ctx.connection;
+        if(!connection->shardIndex)
+        {
+            unsigned shardIndex = 0;
+            for(unsigned k = 1; k < shardCnt; k++) if(shards[k].load < shards[shardIndex].load) shardIndex = k;
+            shards[shardIndex].load += connection->load;
+            connection->shardIndex = shardIndex + 1;
+        }
 
-        // Set IDN-Hello sequence number (used on UDP for lost packet tracking)
-        packetHdr->sequence = htons(ctx->sequence++);
+        IDN_SHARD *shard = &shards[connection->shardIndex - 1];
+        ssn->evl = shard->evl;
+        ssn->ctx.fdSocket = shard->fdSocket;
+        shard->sessionCnt++;
 
-        // Send the packet
-        if(idnSend(ctx, packetHdr, splitPtr - (uint8_t *)packetHdr)) return -1;
+        // Note: Empty shows do not open their channel
+        evlTimerInit(&ssn->timer, ssn->scriptFilename ? idnScriptTimer : idnSessionTimer, ssn);
+        if(!ssn->scriptFilename && !ssn->show.frameCnt) { ssn->doneFlag = 1; connection->openCnt--; }
+    }
+
+    // Acknowledges received by the event loop of the shard (requested by the sessions)
+    for(unsigned i = 0; !rc && tmpl->ctx.ackIntervalNS && (i < shardCnt); i++)
+    {
+        IDN_SHARD *shard = &shards[i];
+        shard->sessions = sessions;
+        shard->allCnt = sessionCnt;
+        for(unsigned k = 0; k < sessionCnt; k++)
+        {
+            if((sessions[k].evl != shard->evl) || sessions[k].doneFlag) continue;
+            sessions[k].activeCnt = &shard->activeCnt;
+            shard->activeCnt++;
+        }
+        if(!shard->activeCnt || (evlWatch(shard->evl, shard->fdSocket, idnShardAckRead, shard) == 0)) continue;
 
-        // Delete config flag (in case set - not config headers in fragments), set sequel fragment chunk type
-        contentID &= ~IDNFLG_CONTENTID_CONFIG_LSTFRG;
-        contentID |= IDNVAL_CNKTYPE_LPGRF_FRAME_SEQUEL;
+        idnLogError("[SSN] Cannot receive acknowledges, -ack ignored");
+        for(unsigned k = 0; k < sessionCnt; k++) { sessions[k].ctx.ackIntervalNS = 0; sessions[k].activeCnt = 0; }
+        break;
+    }
 
-        // Send remaining fragments
-        while(1)
+    // First frames right away, run until all shows are over
+    uint64_t wallStart = plt_readMonoClockNS(), cpuStart = plt_readCPUTimeNS();
+    if(!rc)
+    {
+        unsigned connectionCnt = 0;
+        for(unsigned i = 0; i < sessionCnt; i++) if(sessions[i].ctx.connection == &sessions[i].connection) connectionCnt++;
+        idnLogInfo("[SSN] %u sessions (%u IDN-Hello connections) on %u shard%s, %llu samples decoded", sessionCnt,
+                   connectionCnt, shardCnt, (shardCnt == 1) ? "" : "s", (unsigned long long)sampleCnt);
+
+        uint64_t now = plt_getMonoTimeNS(), start = now;
+        if(tmpl->ctx.timeline) start = tmlGetEpoch(tmpl->ctx.timeline);
+        if(start < now) start = now;
+        for(unsigned i = 0; i < sessionCnt; i++)
         {
-            // Allocate message header (overwrite previous packet data), fragment number shared with timestamp
-            channelMsgHdr = (IDNHDR_CHANNEL_MESSAGE *)(splitPtr - sizeof(IDNHDR_CHANNEL_MESSAGE));
-            channelMsgHdr->timestamp = htonl(++now);
+            if(!sessions[i].doneFlag) evlTimerArm(sessions[i].evl, &sessions[i].timer, start);
+        }
+
+        if(shardCnt == 1)
+        {
+            // Note: This thread was set up for real-time by the caller
+            uint64_t cpuThread = plt_readThreadCPUTimeNS();
+            shards[0].rc = evlRun(shards[0].evl);
+            shards[0].cpuTime = plt_readThreadCPUTimeNS() - cpuThread;
+        }
+        else
+        {
+            unsigned threadCnt = 0;
+            for(; threadCnt < shardCnt; threadCnt++)
+            {
+                if(plt_threadCreate(&shards[threadCnt].thread, idnShardThread, &shards[threadCnt])) break;
+            }
+            if(threadCnt < shardCnt) { idnLogError("[SSN] Shard thread creation failed"); rc = -1; }
+            for(unsigned i = 0; i < threadCnt; i++)
+            {
+                // Note: Without all shards running, the others are stopped at their next wakeup
+                if(rc) evlStop(shards[i].evl);
+                plt_threadJoin(shards[i].thread);
+            }
+        }
+        for(unsigned i = 0; i < shardCnt; i++) if(shards[i].rc) rc = -1;
+    }
+    uint64_t wallTime = plt_readMonoClockNS() - wallStart, cpuTime = plt_readCPUTimeNS() - cpuStart;
+
+    // Report: Summary of all sessions, worst session
+    uint64_t frameCnt = 0, byteCnt = 0;
+    int64_t latenessSum = 0;
+    int32_t latenessMax = 0, jitterMax = 0;
+    uint32_t lateCnt = 0, doneCnt = 0;
+    IDNCONTEXT ackSum;
+    memset(&ackSum, 0, sizeof(ackSum));
+    for(unsigned i = 0; i < sessionCnt; i++)
+    {
+        IDNCONTEXT *ctx = &sessions[i].ctx;
+        if(ctx->ackCnt && (!ackSum.ackCnt || (ctx->ackRttMin < ackSum.ackRttMin))) ackSum.ackRttMin = ctx->ackRttMin;
+        if(ctx->ackRttMax > ackSum.ackRttMax) ackSum.ackRttMax = ctx->ackRttMax;
+        ackSum.ackReqCnt += ctx->ackReqCnt;
+        ackSum.ackCnt += ctx->ackCnt;
+        ackSum.ackLostCnt += ctx->ackLostCnt;
+        ackSum.ackRttSum += ctx->ackRttSum;
+        ackSum.ackErrorCnt += ctx->ackErrorCnt;
+        ackSum.ackEvents |= ctx->ackEvents;
+        ackSum.ackSeqErrCnt += ctx->ackSeqErrCnt;
+        frameCnt += ctx->frameCnt;
+        byteCnt += ctx->byteCnt;
+        latenessSum += ctx->latenessSum;
+        lateCnt += ctx->lateCnt;
+        if(ctx->latenessMax > latenessMax) latenessMax = ctx->latenessMax;
+        if(ctx->jitterMax > jitterMax) jitterMax = ctx->jitterMax;
+        if(sessions[i].doneFlag) doneCnt++;
+    }
+
+    EVLOOP_STATS stats;
+    memset(&stats, 0, sizeof(stats));
+    for(unsigned i = 0; shards && (i < shardCnt); i++)
+    {
+        if(!shards[i].evl) continue;
+
+        EVLOOP_STATS shardStats;
+        evlGetStats(shards[i].evl, &shardStats);
+        stats.wakeupCnt += shardStats.wakeupCnt;
+        stats.timerCnt += shardStats.timerCnt;
+        stats.rearmCnt += shardStats.rearmCnt;
+        stats.delaySum += shardStats.delaySum;
+        if(shardStats.delayMax > stats.delayMax) stats.delayMax = shardStats.delayMax;
+    }
+
+    double wallSec = (double)wallTime / 1e9;
+    idnLogInfo("[SSN] %u of %u sessions completed, %llu frames, lateness avg %d us, max %d us, %u late, jitter max %d us",
+               doneCnt, sessionCnt, (unsigned long long)frameCnt, frameCnt ? (int)(latenessSum / (int64_t)frameCnt) : 0,
+               latenessMax, lateCnt, jitterMax);
+    unsigned scriptCnt = 0, raiseCnt = 0;
+    for(unsigned i = 0; i < sessionCnt; i++) if(sessions[i].scriptFilename) scriptCnt++;
+    for(unsigned i = 0; i < scriptCues.cueCnt; i++) raiseCnt += scriptCues.raiseCnt[i];
+    if(scriptCnt) idnLogInfo("[SSN] Show scripts: %u sessions scripted, %u cues, %u raised", scriptCnt, scriptCues.cueCnt, raiseCnt);
+    idnReportAck(&ackSum, "[SSN]");
+    idnLogInfo("[SSN] Event loop: %llu wakeups, %llu timers (delay avg %u us, max %u us), %llu timer changes",
+               (unsigned long long)stats.wakeupCnt, (unsigned long long)stats.timerCnt,
+               stats.timerCnt ? (unsigned)(stats.delaySum / stats.timerCnt / 1000) : 0, (unsigned)(stats.delayMax / 1000),
+               (unsigned long long)stats.rearmCnt);
+    if(wallTime)
+    {
+        idnLogInfo("[SSN] CPU: %.3f s in %.3f s (%.1f%%), %.1f us per frame, %.1f Mbit/s",
+                   (double)cpuTime / 1e9, wallSec, 100.0 * (double)cpuTime / (double)wallTime,
+                   frameCnt ? (double)cpuTime / 1e3 / (double)frameCnt : 0.0, (double)byteCnt * 8.0 / wallSec / 1e6);
+    }
+    for(unsigned i = 0; wallTime && (shardCnt > 1) && (i < shardCnt); i++)
+    {
+        idnLogInfo("[SSN] Shard %u: CPU %d, %u sessions, estimated load %.1f Mbit/s, CPU %.1f%%",
+                   i, shards[i].cpu, shards[i].sessionCnt, (double)shards[i].load * 8.0 / 1e6,
+                   100.0 * (double)shards[i].cpuTime / (double)wallTime);
+    }
+
+    // Free the sessions and shards
+    idnFreeSessions(sessions, sessionCnt);
+    for(unsigned i = 0; shards && (i < shardCnt); i++)
+    {
+        if((i > 0) && (shards[i].fdSocket >= 0)) plt_sockClose(shards[i].fdSocket);
+        evlDestroy(shards[i].evl);
+    }
+    if(shards) free(shards);
+    if(order) free(order);
+
+    return rc;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  Daemon
+// -------------------------------------------------------------------------------------------------
 
-            // Allocate and populate packet header
-            packetHdr = (IDNHDR_PACKET *)((uint8_t *)channelMsgHdr - sizeof(IDNHDR_PACKET));
-            packetHdr->command = IDNCMD_RT_CNLMSG;
-            packetHdr->flags = ctx->clientGroup;
-            packetHdr->sequence = htons(ctx->sequence++);
+static int idnDecodeShow(IDNCONTEXT *tmplCtx, char *filename, float xyScale, unsigned options, SHOW *show)
+{
+    // Decode into the show with the frame settings of the passed stream. Note: Own context, the
+    // stream is not touched (may run on any thread).
+    IDNCONTEXT ctx;
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.frameRate = tmplCtx->frameRate;
+    ctx.usFrameTime = tmplCtx->usFrameTime;
+    ctx.scanSpeed = tmplCtx->scanSpeed;
+    ctx.colorShift = tmplCtx->colorShift;
+    ctx.processShift = tmplCtx->processShift;
+    ctx.resampleFlag = tmplCtx->resampleFlag;
+    ctx.budgetFlag = tmplCtx->budgetFlag;
+    ctx.jitterFreeFlag = tmplCtx->jitterFreeFlag;
+    ctx.show = show;
+
+    IDTF_CALLBACK_FUNC cbFunc = { 0 };
+    cbFunc.openFrame = idnOpenFrameXYRGB;
+    cbFunc.putSampleXYRGB = idnPutSampleXYRGB;
+    cbFunc.pushFrame = idnPushFrameXYRGB;
+
+    int rc = idtfRead(filename, xyScale, options, &cbFunc, &ctx);
+    if(!rc && !show->frameCnt) { idnLogError("[DMN] %s: No frames", filename); rc = -1; }
+    frmFree(&ctx.processSource);
+    frmFree(&ctx.processTarget);
+    if(ctx.bufferPtr) free(ctx.bufferPtr);
+    if(rc) idnShowFree(show);
+
+    return rc;
+}
 
-            // Calculate remaining message length
-            msgLength = payloadLimit - (uint8_t *)channelMsgHdr;
-            if(msgLength > MAX_IDN_MESSAGE_LEN)
+
+static void idnDaemonReply(IDN_CLIENT *client, const char *fmt, ...)
+{
+    char reply[MAX_SESSION_LINE];
+    va_list arg_ptr;
+    va_start(arg_ptr, fmt);
+    int len = vsnprintf(reply, sizeof(reply) - 1, fmt, arg_ptr);
+    va_end(arg_ptr);
+    if(len < 0) return;
+    if(len > (int)sizeof(reply) - 2) len = (int)sizeof(reply) - 2;
+    reply[len++] = '\n';
+
+    // Note: Short replies, a client that does not read them loses them
+    if(plt_sockSend(client->fd, reply, (unsigned)len) < 0) { }
+}
+
+
+static IDN_CUE *idnDaemonCue(IDN_DAEMON *dmn, const char *filename)
+{
+    // Shows are decoded once and kept. New ones are added for loading (see idnDaemonDecoder()).
+    for(unsigned i = 0; i < dmn->cueCnt; i++)
+    {
+        if(!strcmp(dmn->cues[i].filename, filename)) return &dmn->cues[i];
+    }
+    if(dmn->cueCnt == MAX_DAEMON_CUES) { idnLogError("[DMN] More than %u shows", MAX_DAEMON_CUES); return (IDN_CUE *)0; }
+
+    IDN_CUE *cue = &dmn->cues[dmn->cueCnt];
+    memset(cue, 0, sizeof(IDN_CUE));
+    cue->filename = strdup(filename);
+    if(!cue->filename) return (IDN_CUE *)0;
+
+    cue->loadFlag = 1;
+    dmn->cueCnt++;
+    return cue;
+}
+
+
+static void idnDaemonDropCue(IDN_DAEMON *dmn, IDN_CUE *cue)
+{
+    // Show that failed to load. Note: Not playing, references to the later shows move along.
+    free(cue->filename);
+    unsigned index = (unsigned)(cue - dmn->cues);
+    memmove(cue, cue + 1, (dmn->cueCnt - index - 1) * sizeof(IDN_CUE));
+    dmn->cueCnt--;
+
+    if(dmn->cue > cue) dmn->cue--;
+    if(dmn->pendingCue > cue) dmn->pendingCue--;
+    for(unsigned i = 0; i < MAX_DAEMON_CLIENTS; i++)
+    {
+        if(dmn->clients[i].waitCue > cue) dmn->clients[i].waitCue--;
+    }
+}
+
+
+static void idnDaemonTimer(void *context, uint64_t now)
+{
+    IDN_DAEMON *dmn = (IDN_DAEMON *)context;
+    IDNCONTEXT *ctx = &dmn->ctx;
+
+    // Apply a command at the frame boundary (right away when no frames are due). Note: A show still
+    // loading keeps the current one going, the command is applied once it is decoded.
+    int rc = 0;
+    int readyFlag = !dmn->pendingCue || !dmn->pendingCue->loadFlag;
+    if(dmn->pendingOp && readyFlag && (!dmn->playFlag || dmn->heldFlag || (now >= dmn->dueTime)))
+    {
+        if((dmn->pendingOp == DAEMON_OP_PLAY) || (dmn->pendingOp == DAEMON_OP_SWITCH))
+        {
+            unsigned frameIndex = dmn->pendingFrame;
+            if(dmn->pendingOp == DAEMON_OP_SWITCH) frameIndex = dmn->playFlag ? dmn->frameIndex % dmn->pendingCue->show.frameCnt : 0;
+
+            // Note: Starting anew (channel closed) starts a new schedule
+            if(!dmn->playFlag && !ctx->timeline)
             {
-                // Middle sequel fragment
-                channelMsgHdr->totalSize = htons(MAX_IDN_MESSAGE_LEN);
-                channelMsgHdr->contentID = htons(contentID);
-                splitPtr = (uint8_t *)channelMsgHdr + MAX_IDN_MESSAGE_LEN;
+                ctx->scheduleIndex = 0;
+                ctx->lastSendTime = 0;
+            }
+            dmn->cue = dmn->pendingCue;
+            dmn->frameIndex = frameIndex;
+            dmn->playFlag = 1;
+            dmn->heldFlag = 0;
+            dmn->dueTime = now;
+            dmn->latencyStart = dmn->pendingTime;
+        }
+        else
+        {
+            if(dmn->playFlag) rc = idnSendChannelClose(ctx);
+            dmn->playFlag = 0;
+            dmn->latencyStart = 0;
+
+            uint64_t latency = plt_getMonoTimeNS() - dmn->pendingTime;
+            dmn->latencyCnt++;
+            dmn->latencySum += latency;
+            if(latency > dmn->latencyMax) dmn->latencyMax = latency;
+            if(dmn->pendingOp == DAEMON_OP_QUIT) evlStop(dmn->evl);
+        }
 
-                // Send the packet
-                if(idnSend(ctx, packetHdr, splitPtr - (uint8_t *)packetHdr)) return -1;
+        dmn->commandCnt++;
+        dmn->pendingOp = DAEMON_OP_NONE;
+    }
+
+    if(!rc && dmn->playFlag && !dmn->heldFlag && (now >= dmn->dueTime))
+    {
+        // Frame due. Shows loop, single-frame shows are held.
+        SHOW *show = &dmn->cue->show;
+        uint64_t deadline = 0;
+        int wait = idnWaitDeadline(ctx, &deadline);
+        if(wait == WAIT_DEADLINE_SEND)
+        {
+            rc = idnSendShowFrame(ctx, &show->frames[dmn->frameIndex], deadline);
+            if(dmn->latencyStart)
+            {
+                uint64_t latency = plt_getMonoTimeNS() - dmn->latencyStart;
+                dmn->latencyCnt++;
+                dmn->latencySum += latency;
+                if(latency > dmn->latencyMax) dmn->latencyMax = latency;
+                dmn->latencyStart = 0;
             }
+        }
+        if(wait == WAIT_DEADLINE_EARLY)
+        {
+            // Frame held back (shaper debt), same frame again
+            dmn->dueTime = deadline;
+        }
+        else
+        {
+            if(++dmn->frameIndex >= show->frameCnt) dmn->frameIndex = 0;
+            if(show->frameCnt == 1) dmn->heldFlag = 1;
+            dmn->dueTime = idnFrameDeadline(ctx);
+        }
+    }
+    else if(!rc && ctx->keepaliveNS && ctx->lastTxTime && (now >= ctx->lastTxTime + ctx->keepaliveNS))
+    {
+        // Nothing sent for the keepalive interval (session kept open while stopped)
+        rc = idnSendVoid(ctx);
+    }
+
+    if(rc)
+    {
+        idnLogError("[DMN] Send failed");
+        evlStop(dmn->evl);
+        return;
+    }
+
+    // Wake up for the next frame or when the session would go quiet for too long
+    uint64_t wakeTime = UINT64_MAX;
+    if(dmn->playFlag && !dmn->heldFlag) wakeTime = dmn->dueTime;
+    if(ctx->keepaliveNS && ctx->lastTxTime && (ctx->lastTxTime + ctx->keepaliveNS < wakeTime)) wakeTime = ctx->lastTxTime + ctx->keepaliveNS;
+    if(wakeTime != UINT64_MAX) evlTimerArm(dmn->evl, &dmn->timer, wakeTime);
+}
+
+
+static PLT_THREAD_RESULT PLT_THREAD_CALL idnDaemonDecodeThread(void *arg)
+{
+    IDN_DAEMON *dmn = (IDN_DAEMON *)arg;
+    IDN_CUE *cue = dmn->decodeCue;
+
+    // Reload: Incomplete files (no end section) are rejected
+    unsigned options = cue->loadFlag ? dmn->options : (dmn->options | IDTFOPT_REQUIRE_END);
+    int rc = idnDecodeShow(&dmn->ctx, cue->filename, dmn->xyScale, options, &dmn->decodeShow);
+
+    // Reload: The file must not have been written meanwhile (the next change reloads it again).
+    // Note: A version written while loading is reloaded (stamp taken ahead).
+    uint64_t mtimeNS = 0, size = 0;
+    if(!rc && !cue->loadFlag &&
+       (plt_getFileStamp(cue->filename, &mtimeNS, &size) || (mtimeNS != dmn->decodeMtime) || (size != dmn->decodeSize)))
+    {
+        idnLogError("[DMN] %s: Written while decoding", cue->filename);
+        idnShowFree(&dmn->decodeShow);
+        rc = -1;
+    }
+
+    dmn->decodeRc = rc;
+    plt_atomicStore32(&dmn->decodeDone, 1);
+
+    return 0;
+}
+
+
+static int idnDaemonStartDecode(IDN_DAEMON *dmn, IDN_CUE *cue, int threadFlag)
+{
+    // Decode in the background (frames keep going out meanwhile) or right away (nothing playing).
+    // Note: Load stamp taken ahead, a version written while decoding is reloaded.
+    if(cue->loadFlag && plt_getFileStamp(cue->filename, &dmn->decodeMtime, &dmn->decodeSize))
+    {
+        dmn->decodeMtime = 0;
+        dmn->decodeSize = 0;
+    }
+    dmn->decodeCue = cue;
+    dmn->decodeStart = plt_getMonoTimeNS();
+    plt_atomicStore32(&dmn->decodeDone, 0);
+    memset(&dmn->decodeShow, 0, sizeof(SHOW));
+
+    if(!threadFlag) { idnDaemonDecodeThread(dmn); return 0; }
+    if(plt_threadCreate(&dmn->decodeThread, idnDaemonDecodeThread, dmn))
+    {
+        idnLogError("[DMN] %s: Decoder thread creation failed", cue->filename);
+        dmn->decodeCue = (IDN_CUE *)0;
+        return -1;
+    }
+
+    return 0;
+}
+
+
+static int idnDaemonLoaded(IDN_DAEMON *dmn, uint64_t now)
+{
+    // First decode of a show done (loop thread). Replies to the load commands waiting for it, a
+    // play command waiting for it is applied at the next frame boundary.
+    IDN_CUE *cue = dmn->decodeCue;
+    dmn->decodeCue = (IDN_CUE *)0;
+
+    int rc = dmn->decodeRc;
+    for(unsigned i = 0; i < MAX_DAEMON_CLIENTS; i++)
+    {
+        IDN_CLIENT *client = &dmn->clients[i];
+        if((client->fd < 0) || (client->waitCue != cue)) continue;
+
+        if(rc) idnDaemonReply(client, "ERR cannot load %s", cue->filename);
+        else idnDaemonReply(client, "OK %s: %u frames", cue->filename, dmn->decodeShow.frameCnt);
+        client->waitCue = (IDN_CUE *)0;
+    }
+
+    if(rc)
+    {
+        idnLogError("[DMN] %s: Cannot load", cue->filename);
+        if(dmn->pendingCue == cue) { dmn->pendingOp = DAEMON_OP_NONE; dmn->pendingCue = (IDN_CUE *)0; }
+        idnDaemonDropCue(dmn, cue);
+        return -1;
+    }
+
+    memcpy(&cue->show, &dmn->decodeShow, sizeof(SHOW));
+    memset(&dmn->decodeShow, 0, sizeof(SHOW));
+    cue->mtimeNS = dmn->decodeMtime;
+    cue->size = dmn->decodeSize;
+    cue->loadFlag = 0;
+    if((dmn->fdWatch >= 0) && plt_fileWatchAdd(dmn->fdWatch, cue->filename))
+    {
+        idnLogError("[DMN] %s: Cannot watch for changes (error: %d)", cue->filename, errno);
+    }
+
+    idnLogInfo("[DMN] %s: %u frames decoded in %u ms", cue->filename, cue->show.frameCnt,
+               (unsigned)((plt_getMonoTimeNS() - dmn->decodeStart) / 1000000));
+
+    if(dmn->pendingOp && (dmn->pendingCue == cue) && (!dmn->playFlag || dmn->heldFlag)) evlTimerArm(dmn->evl, &dmn->timer, now);
+    return 0;
+}
+
+
+static void idnDaemonSwap(IDN_DAEMON *dmn, IDN_CUE *cue, uint64_t now)
+{
+    // Frames are sent by the loop thread (timer callback), so this is a frame boundary
+    idnShowFree(&cue->show);
+    memcpy(&cue->show, &dmn->decodeShow, sizeof(SHOW));
+    memset(&dmn->decodeShow, 0, sizeof(SHOW));
+    cue->mtimeNS = dmn->decodeMtime;
+    cue->size = dmn->decodeSize;
+    dmn->reloadCnt++;
+
+    // Same position in the new version, a held frame is replaced right away
+    if(dmn->pendingCue == cue) dmn->pendingFrame %= cue->show.frameCnt;
+    if(dmn->cue == cue)
+    {
+        dmn->frameIndex %= cue->show.frameCnt;
+        if(dmn->playFlag && dmn->heldFlag)
+        {
+            dmn->heldFlag = 0;
+            dmn->dueTime = now;
+            evlTimerArm(dmn->evl, &dmn->timer, now);
+        }
+    }
+
+    idnLogInfo("[DMN] %s: Reloaded, %u frames decoded in %u ms", cue->filename, cue->show.frameCnt,
+               (unsigned)((plt_getMonoTimeNS() - dmn->decodeStart) / 1000000));
+}
+
+
+static void idnDaemonDecoder(void *context, uint64_t now)
+{
+    IDN_DAEMON *dmn = (IDN_DAEMON *)context;
+
+    // Background decode: Hand the show over when complete. Reloads are swapped in, the previous
+    // version is kept when the new one is rejected.
+    if(dmn->decodeCue)
+    {
+        if(!plt_atomicLoad32(&dmn->decodeDone))
+        {
+            evlTimerArm(dmn->evl, &dmn->decodeTimer, now + WATCH_POLL_TIME * 1000000ull);
+            return;
+        }
+
+        plt_threadJoin(dmn->decodeThread);
+        IDN_CUE *cue = dmn->decodeCue;
+        if(cue->loadFlag) idnDaemonLoaded(dmn, now);
+        else
+        {
+            dmn->decodeCue = (IDN_CUE *)0;
+            if(!dmn->decodeRc) idnDaemonSwap(dmn, cue, now);
             else
             {
-                // Last sequel fragment, set last fragment flag
-                channelMsgHdr->totalSize = htons((unsigned short)msgLength);
-                channelMsgHdr->contentID = htons(contentID | IDNFLG_CONTENTID_CONFIG_LSTFRG);
+                idnLogError("[DMN] %s: New version rejected, previous one kept", cue->filename);
+                dmn->rejectCnt++;
+            }
+        }
+    }
 
-                // Send the packet
-                if(idnSend(ctx, packetHdr, payloadLimit - (uint8_t *)packetHdr)) return -1;
+    // Shows to load first (commands wait for them), one at a time
+    for(unsigned i = 0; i < dmn->cueCnt; i++)
+    {
+        IDN_CUE *cue = &dmn->cues[i];
+        if(!cue->loadFlag) continue;
 
-                // Done sending the packet
-                break;
-            }
+        if(idnDaemonStartDecode(dmn, cue, 1))
+        {
+            dmn->decodeRc = -1;
+            dmn->decodeCue = cue;
+            idnDaemonLoaded(dmn, now);
+            i--;
+            continue;
+        }
+
+        evlTimerArm(dmn->evl, &dmn->decodeTimer, now + WATCH_POLL_TIME * 1000000ull);
+        return;
+    }
+
+    // Wait for the writes to settle (exporters may close the file several times)
+    if(now < dmn->settleTime)
+    {
+        evlTimerArm(dmn->evl, &dmn->decodeTimer, dmn->settleTime);
+        return;
+    }
+
+    // Reload the next changed show (one at a time)
+    for(unsigned i = 0; i < dmn->cueCnt; i++)
+    {
+        IDN_CUE *cue = &dmn->cues[i];
+        if(!cue->reloadFlag) continue;
+        cue->reloadFlag = 0;
+
+        // Note: Changed back or reloaded meanwhile
+        if(plt_getFileStamp(cue->filename, &dmn->decodeMtime, &dmn->decodeSize)) continue;
+        if((dmn->decodeMtime == cue->mtimeNS) && (dmn->decodeSize == cue->size)) continue;
+        if(idnDaemonStartDecode(dmn, cue, 1)) continue;
+
+        evlTimerArm(dmn->evl, &dmn->decodeTimer, now + WATCH_POLL_TIME * 1000000ull);
+        return;
+    }
+}
+
+
+static void idnDaemonWatch(void *context, int fd)
+{
+    IDN_DAEMON *dmn = (IDN_DAEMON *)context;
+    if(!plt_fileWatchRead(fd)) return;
+
+    // Any file of the watched directories: Check the versions of the shows
+    unsigned changeCnt = 0;
+    for(unsigned i = 0; i < dmn->cueCnt; i++)
+    {
+        IDN_CUE *cue = &dmn->cues[i];
+        uint64_t mtimeNS = 0, size = 0;
+        if(plt_getFileStamp(cue->filename, &mtimeNS, &size)) continue;
+        if((mtimeNS == cue->mtimeNS) && (size == cue->size)) continue;
+
+        cue->reloadFlag = 1;
+        changeCnt++;
+    }
+    if(!changeCnt) return;
+
+    // Note: A decode in progress or shows to load check the settle time when done
+    dmn->settleTime = plt_getMonoTimeNS() + WATCH_SETTLE_TIME * 1000000ull;
+    for(unsigned i = 0; i < dmn->cueCnt; i++) if(dmn->cues[i].loadFlag) return;
+    if(!dmn->decodeCue) evlTimerArm(dmn->evl, &dmn->decodeTimer, dmn->settleTime);
+}
+
+
+static void idnDaemonCommand(IDN_DAEMON *dmn, IDN_CLIENT *client, char *line)
+{
+    // Command word and argument (rest of the line, file names may contain blanks)
+    uint64_t now = plt_getMonoTimeNS();
+    while((*line == ' ') || (*line == '\t')) line++;
+    char *arg = line;
+    while(*arg && (*arg != ' ') && (*arg != '\t')) arg++;
+    if(*arg) *arg++ = 0;
+    while((*arg == ' ') || (*arg == '\t')) arg++;
+    char *argEnd = arg + strlen(arg);
+    while((argEnd > arg) && ((argEnd[-1] == ' ') || (argEnd[-1] == '\t') || (argEnd[-1] == '\r'))) *--argEnd = 0;
+
+    int op = DAEMON_OP_NONE;
+    IDN_CUE *cue = (IDN_CUE *)0;
+    unsigned frameIndex = 0;
+    if(!strcmp(line, "load") || !strcmp(line, "play") || !strcmp(line, "switch"))
+    {
+        if(!*arg) { idnDaemonReply(client, "ERR missing file name"); return; }
+
+        // New shows are decoded in the background, the frames keep going out meanwhile
+        cue = idnDaemonCue(dmn, arg);
+        if(!cue) { idnDaemonReply(client, "ERR cannot load %s", arg); return; }
+        if(cue->loadFlag && !dmn->decodeCue) evlTimerArm(dmn->evl, &dmn->decodeTimer, now);
+        if(!strcmp(line, "load"))
+        {
+            // Note: Replied when decoded
+            if(cue->loadFlag) client->waitCue = cue;
+            else idnDaemonReply(client, "OK %s: %u frames", cue->filename, cue->show.frameCnt);
+            return;
+        }
+
+        // Play: Applied once decoded. Switch: Same position in the new show.
+        op = strcmp(line, "switch") ? DAEMON_OP_PLAY : DAEMON_OP_SWITCH;
+    }
+    else if(!strcmp(line, "seek"))
+    {
+        int pendingPlay = (dmn->pendingOp == DAEMON_OP_PLAY) || (dmn->pendingOp == DAEMON_OP_SWITCH);
+        IDN_CUE *current = pendingPlay ? dmn->pendingCue : (dmn->playFlag ? dmn->cue : (IDN_CUE *)0);
+        if(!current) { idnDaemonReply(client, "ERR not playing"); return; }
+        if(current->loadFlag) { idnDaemonReply(client, "ERR %s still loading", current->filename); return; }
+
+        int param = atoi(arg);
+        if((param < 0) || ((unsigned)param >= current->show.frameCnt))
+        {
+            idnDaemonReply(client, "ERR frame %d out of range (%u frames)", param, current->show.frameCnt);
+            return;
         }
+        cue = current;
+        frameIndex = (unsigned)param;
+        op = DAEMON_OP_PLAY;
+    }
+    else if(!strcmp(line, "stop"))
+    {
+        op = DAEMON_OP_STOP;
+    }
+    else if(!strcmp(line, "quit"))
+    {
+        op = DAEMON_OP_QUIT;
+    }
+    else if(!strcmp(line, "status"))
+    {
+        idnDaemonReply(client, "OK %s %s frame %u, %u shows, %u frames sent, latency avg %u us, max %u us",
+                       dmn->playFlag ? "playing" : "stopped", dmn->cue ? dmn->cue->filename : "-", dmn->frameIndex,
+                       dmn->cueCnt, dmn->ctx.frameCnt,
+                       dmn->latencyCnt ? (unsigned)(dmn->latencySum / dmn->latencyCnt / 1000) : 0,
+                       (unsigned)(dmn->latencyMax / 1000));
+        return;
     }
     else
     {
-        // Regular frame (single message), set message length and chunk type
-        channelMsgHdr->totalSize = htons((unsigned short)msgLength);
-        channelMsgHdr->contentID = htons(contentID | IDNVAL_CNKTYPE_LPGRF_FRAME);
+        if(*line) idnDaemonReply(client, "ERR unknown command '%s' (load, play, switch, seek, stop, status, quit)", line);
+        return;
+    }
+
+    // Applied at the next frame boundary. Note: A later command replaces one not applied yet.
+    dmn->pendingOp = op;
+    dmn->pendingCue = cue;
+    dmn->pendingFrame = frameIndex;
+    dmn->pendingTime = now;
+    if(!dmn->playFlag || dmn->heldFlag) evlTimerArm(dmn->evl, &dmn->timer, now);
+    idnDaemonReply(client, "OK");
+}
+
+
+static void idnDaemonClientClose(IDN_DAEMON *dmn, IDN_CLIENT *client)
+{
+    evlUnwatch(dmn->evl, client->fd);
+    plt_sockClose(client->fd);
+    client->fd = -1;
+}
+
+
+static void idnDaemonClientRead(void *context, int fd)
+{
+    IDN_DAEMON *dmn = (IDN_DAEMON *)context;
+    IDN_CLIENT *client = (IDN_CLIENT *)0;
+    for(unsigned i = 0; i < MAX_DAEMON_CLIENTS; i++) if(dmn->clients[i].fd == fd) client = &dmn->clients[i];
+    if(!client) return;
 
-        // Set IDN-Hello sequence number (used on UDP for lost packet tracking)
-        packetHdr->sequence = htons(ctx->sequence++);
+    char buffer[512];
+    int len = (int)recv(fd, buffer, sizeof(buffer), 0);
+    if(len <= 0) { idnDaemonClientClose(dmn, client); return; }
 
-        // Send the packet
-        if(idnSend(ctx, packetHdr, payloadLimit - (uint8_t *)packetHdr)) return -1;
+    // Split into lines, overlong lines are dropped
+    for(int i = 0; i < len; i++)
+    {
+        if(buffer[i] == '\n')
+        {
+            if(client->lineLen < sizeof(client->line))
+            {
+                client->line[client->lineLen] = 0;
+                idnDaemonCommand(dmn, client, client->line);
+            }
+            else idnDaemonReply(client, "ERR line too long");
+            client->lineLen = 0;
+        }
+        else if(client->lineLen < sizeof(client->line))
+        {
+            // Note: A full buffer marks an overlong line (no room for the terminator)
+            client->line[client->lineLen++] = buffer[i];
+        }
     }
-
-    // Invalidate payload - cause error in case of invalid call order
-    ctx->payloadLen = 0;
-
-    return 0;
 }
 
 
-int idnSendVoid(void *context)
+static void idnDaemonAccept(void *context, int fd)
 {
-    IDNCONTEXT *ctx = (IDNCONTEXT *)context;
-
-    // Sanity check (buffer already in use?)
-    if(ctx->payloadLen != 0) return -1;
+    IDN_DAEMON *dmn = (IDN_DAEMON *)context;
 
-    // Make sure there is enough buffer
-    if(ensureBufferCapacity(ctx, 0x1000)) return -1;
+    int fdClient = plt_sockAccept(fd);
+    if(fdClient < 0) return;
 
-    // IDN-Hello packet header
-    IDNHDR_PACKET *packetHdr = (IDNHDR_PACKET *)ctx->bufferPtr;
-    packetHdr->command = IDNCMD_RT_CNLMSG;
-    packetHdr->flags = ctx->clientGroup;
-    packetHdr->sequence = htons(ctx->sequence++);
-
-    // IDN-Stream channel message header
-    IDNHDR_CHANNEL_MESSAGE *channelMsgHdr = (IDNHDR_CHANNEL_MESSAGE *)&packetHdr[1];
-    uint16_t contentID = IDNFLG_CONTENTID_CHANNELMSG | IDNVAL_CNKTYPE_VOID;
-    channelMsgHdr->contentID = htons(contentID);
-
-    // Pointer to the end of the buffer for message length and packet length calculation
-    uint8_t *payloadLimit = (uint8_t *)&channelMsgHdr[1];
+    for(unsigned i = 0; i < MAX_DAEMON_CLIENTS; i++)
+    {
+        IDN_CLIENT *client = &dmn->clients[i];
+        if(client->fd >= 0) continue;
 
-    // Populate message header fields
-    channelMsgHdr->totalSize = htons((unsigned short)(payloadLimit - (uint8_t *)channelMsgHdr));
-    channelMsgHdr->timestamp = htonl(plt_getMonoTimeUS());
+        client->fd = fdClient;
+        client->lineLen = 0;
+        client->waitCue = (IDN_CUE *)0;
+        if(evlWatch(dmn->evl, fdClient, idnDaemonClientRead, dmn) == 0) return;
 
-    // Send the packet
-    if(idnSend(context, packetHdr, payloadLimit - (uint8_t *)packetHdr)) return -1;
+        client->fd = -1;
+        break;
+    }
 
-    return 0;
+    idnLogError("[DMN] Too many control connections");
+    plt_sockClose(fdClient);
 }
 
 
-int idnSendClose(void *context)
+static void idnDaemonAckRead(void *context, int fd)
 {
-    IDNCONTEXT *ctx = (IDNCONTEXT *)context;
-
-    // Sanity check (buffer already in use?)
-    if(ctx->payloadLen != 0) return -1;
-
-    // Make sure there is enough buffer
-    if(ensureBufferCapacity(ctx, 0x1000)) return -1;
-
-    // Close the channel: IDN-Hello packet header
-    IDNHDR_PACKET *packetHdr = (IDNHDR_PACKET *)ctx->bufferPtr;
-    packetHdr->command = IDNCMD_RT_CNLMSG;
-    packetHdr->flags = ctx->clientGroup;
-    packetHdr->sequence = htons(ctx->sequence++);
+    IDN_DAEMON *dmn = (IDN_DAEMON *)context;
+    idnPollAck(&dmn->ctx);
+}
 
-    // IDN-Stream channel message header
-    IDNHDR_CHANNEL_MESSAGE *channelMsgHdr = (IDNHDR_CHANNEL_MESSAGE *)&packetHdr[1];
-    uint16_t contentID = IDNFLG_CONTENTID_CHANNELMSG | IDNFLG_CONTENTID_CONFIG_LSTFRG | IDNVAL_CNKTYPE_VOID;
-    channelMsgHdr->contentID = htons(contentID);
 
-    // IDN-Stream channel config header (close channel)
-    IDNHDR_CHANNEL_CONFIG *channelConfigHdr = (IDNHDR_CHANNEL_CONFIG *)&channelMsgHdr[1];
-    channelConfigHdr->wordCount = 0;
-    channelConfigHdr->flags = IDNFLG_CHNCFG_CLOSE;
-    channelConfigHdr->serviceID = 0;
-    channelConfigHdr->serviceMode = 0;
+static int idnRunDaemon(IDNCONTEXT *ctx, const char *socketPath, char *idtfFilename, float xyScale, unsigned options,
+                        int watchFlag)
+{
+    // Keep the session, socket and decoded shows while commands come in on the control socket.
+    // Without control socket, the show of the command line is played until stopped.
+    IDN_DAEMON *dmn = (IDN_DAEMON *)calloc(1, sizeof(IDN_DAEMON));
+    if(!dmn) return -1;
+    memcpy(&dmn->ctx, ctx, sizeof(IDNCONTEXT));
+    dmn->xyScale = xyScale;
+    dmn->options = options;
+    dmn->socketPath = socketPath;
+    for(unsigned i = 0; i < MAX_DAEMON_CLIENTS; i++) dmn->clients[i].fd = -1;
+    dmn->fdListen = -1;
+    dmn->fdWatch = -1;
+
+    int rc = 0;
+    dmn->evl = evlCreate();
+    if(!dmn->evl) rc = -1;
+    else if(socketPath)
+    {
+        dmn->fdListen = plt_localListen(socketPath);
+        if(dmn->fdListen < 0) { idnLogError("[DMN] Cannot listen on %s (error: %d)", socketPath, plt_sockGetLastError()); rc = -1; }
+        else if(evlWatch(dmn->evl, dmn->fdListen, idnDaemonAccept, dmn)) rc = -1;
+    }
+    evlTimerInit(&dmn->timer, idnDaemonTimer, dmn);
+    evlTimerInit(&dmn->decodeTimer, idnDaemonDecoder, dmn);
 
-    // Pointer to the end of the buffer for message length and packet length calculation
-    uint8_t *payloadLimit = (uint8_t *)&channelConfigHdr[1];
+    // Acknowledges received by the event loop (requested by the stream)
+    if(!rc && dmn->ctx.ackIntervalNS && evlWatch(dmn->evl, dmn->ctx.fdSocket, idnDaemonAckRead, dmn))
+    {
+        idnLogError("[DMN] Cannot receive acknowledges, -ack ignored");
+        dmn->ctx.ackIntervalNS = 0;
+    }
 
-    // Populate message header fields
-    channelMsgHdr->totalSize = htons((unsigned short)(payloadLimit - (uint8_t *)channelMsgHdr));
-    channelMsgHdr->timestamp = htonl(plt_getMonoTimeUS());
+    // Hot reload: Shows changed on disk are decoded in the background and swapped in
+    if(!rc && watchFlag)
+    {
+        dmn->fdWatch = plt_fileWatchOpen();
+        if(dmn->fdWatch < 0) { idnLogError("[DMN] File change notification not available (error: %d)", errno); rc = -1; }
+        else if(evlWatch(dmn->evl, dmn->fdWatch, idnDaemonWatch, dmn)) rc = -1;
+    }
 
-    // Send the packet
-    if(idnSend(context, packetHdr, payloadLimit - (uint8_t *)packetHdr)) return -1;
+    // Start with the show of the command line
+    if(!rc && idtfFilename)
+    {
+        // Note: Nothing playing yet, decoded right away
+        IDN_CUE *cue = idnDaemonCue(dmn, idtfFilename);
+        if(!cue) rc = -1;
+        else if(idnDaemonStartDecode(dmn, cue, 0) || idnDaemonLoaded(dmn, plt_getMonoTimeNS())) rc = -1;
+        else
+        {
+            dmn->pendingOp = DAEMON_OP_PLAY;
+            dmn->pendingCue = cue;
+            dmn->pendingTime = plt_getMonoTimeNS();
+            evlTimerArm(dmn->evl, &dmn->timer, dmn->pendingTime);
+        }
+    }
 
-    // ---------------------------------------------------------------------------------------------
+    if(!rc)
+    {
+        if(socketPath) idnLogInfo("[DMN] Listening on %s", socketPath);
+        if(watchFlag) idnLogInfo("[DMN] Watching the shows for changes");
+        rc = evlRun(dmn->evl);
+        idnSendClose(&dmn->ctx);
+    }
 
-    // Close the connection/session: IDN-Hello packet header
-    packetHdr->command = IDNCMD_RT_CNLMSG_CLOSE;
-    packetHdr->flags = ctx->clientGroup;
-    packetHdr->sequence = htons(ctx->sequence++);
+    idnLogInfo("[DMN] %u commands, command-to-output latency avg %u us, max %u us, %u frames sent", dmn->commandCnt,
+               dmn->latencyCnt ? (unsigned)(dmn->latencySum / dmn->latencyCnt / 1000) : 0,
+               (unsigned)(dmn->latencyMax / 1000), dmn->ctx.frameCnt);
+    if(watchFlag) idnLogInfo("[DMN] Hot reload: %u shows swapped, %u versions rejected", dmn->reloadCnt, dmn->rejectCnt);
 
-    // Send the packet (gracefully close session)
-    if(idnSend(context, packetHdr, sizeof(IDNHDR_PACKET))) return -1;
+    // Hand the stream back for the reports, free the shows
+    for(unsigned i = 0; i < MAX_DAEMON_CLIENTS; i++) if(dmn->clients[i].fd >= 0) idnDaemonClientClose(dmn, &dmn->clients[i]);
+    if(dmn->fdListen >= 0) plt_localClose(dmn->fdListen, socketPath);
+    if(dmn->decodeCue)
+    {
+        plt_threadJoin(dmn->decodeThread);
+        if(!dmn->decodeRc) idnShowFree(&dmn->decodeShow);
+    }
+    if(dmn->fdWatch >= 0) plt_fileWatchClose(dmn->fdWatch);
+    if(dmn->evl) evlTimerCancel(dmn->evl, &dmn->decodeTimer);
+    if(dmn->evl) evlTimerCancel(dmn->evl, &dmn->timer);
+    evlDestroy(dmn->evl);
+    for(unsigned i = 0; i < dmn->cueCnt; i++)
+    {
+        idnShowFree(&dmn->cues[i].show);
+        free(dmn->cues[i].filename);
+    }
+    memcpy(ctx, &dmn->ctx, sizeof(IDNCONTEXT));
+    free(dmn);
 
-    return 0;
+    return rc;
 }
 
 
@@ -592,18 +1874,56 @@ int idnSendClose(void *context)
 
 int main(int argc, char **argv)
 {
+    idnSetLogFunc(logStdout, (void *)0);
+
     int usageFlag = 0;
     in_addr_t helloServerAddr = 0;
     unsigned char clientGroup = 0;
     unsigned char serviceID = 0;
     char *idtfFilename = 0;
+    char *playlist[MAX_PLAYLIST];
+    unsigned playlistCnt = 0;
     unsigned holdTime = 5;
+    unsigned keepaliveTime = DEFAULT_KEEPALIVE;
+    unsigned ackInterval = 0;
     unsigned frameRate = DEFAULT_FRAMERATE;
     int jitterFreeFlag = 0;
     unsigned scanSpeed = DEFAULT_SCANSPEED;
     unsigned colorShift = 0;
     float xyScale = 1.0;
     unsigned options = 0;
+    int txTimeClock = -1;
+    unsigned txLeadTime = DEFAULT_TXLEADTIME;
+    int txEngine = 0;
+    int shapeFlag = 0;
+    int latePolicy = LATE_POLICY_SEND;
+    unsigned spinTime = 0;
+    uint64_t shapeRate = 0, linkRate = 0;
+    unsigned shapeBurst = 0, linkBurst = 0;
+    unsigned lookahead = FRAMEQUEUE_DEFAULT_DEPTH;
+    int lookaheadFlag = 0;
+    int rtCpu = -1;
+    int rtPriority = 0;
+    int mlockFlag = 0;
+    int virtualClockFlag = 0;
+    unsigned waveTime = 0;
+    int resampleFlag = 0;
+    int budgetFlag = 0;
+    char *sessionsFilename = 0;
+    char *scriptFilename = 0;
+    unsigned shardCnt = 1;
+    IDN_HEAD_ROUTE headRoutes[MAX_HEADS];
+    unsigned headCnt = 0;
+    int syncFlag = 0;
+    char *syncName = 0;
+    char *daemonPath = 0;
+    int watchFlag = 0;
+    uint32_t pingAddrs[PING_MAX_TARGETS];
+    unsigned pingCnt = 0;
+    unsigned pingRate = PING_DEFAULT_RATE;
+    unsigned pingSize = PING_DEFAULT_PAYLOAD;
+    unsigned pingTime = DEFAULT_PINGTIME;
+    PING_PROBE *probe = (PING_PROBE *)0;
 
 
     for(int i = 1; i < argc; i++)
@@ -629,8 +1949,9 @@ int main(int argc, char **argv)
         }
         else if(!strcmp(argv[i], "-idtf"))
         {
-            if(++i >= argc) { usageFlag = 1; break; }
-            idtfFilename = argv[i];
+            if((++i >= argc) || (playlistCnt == MAX_PLAYLIST)) { usageFlag = 1; break; }
+            if(!idtfFilename) idtfFilename = argv[i];
+            playlist[playlistCnt++] = argv[i];
         }
         else if(!strcmp(argv[i], "-hold"))
         {
@@ -638,6 +1959,41 @@ int main(int argc, char **argv)
             int param = atoi(argv[i]);
             if(param > 0) holdTime = param;
         }
+        else if(!strcmp(argv[i], "-ka"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            keepaliveTime = atoi(argv[i]);
+        }
+        else if(!strcmp(argv[i], "-ack"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            ackInterval = atoi(argv[i]);
+        }
+        else if(!strcmp(argv[i], "-ping"))
+        {
+            if((++i >= argc) || (pingCnt == PING_MAX_TARGETS)) { usageFlag = 1; break; }
+            pingAddrs[pingCnt++] = inet_addr(argv[i]);
+        }
+        else if(!strcmp(argv[i], "-pingrate"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            int param = atoi(argv[i]);
+            if((param <= 0) || (param > 10000)) { usageFlag = 1; break; }
+            else pingRate = param;
+        }
+        else if(!strcmp(argv[i], "-pingsize"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            int param = atoi(argv[i]);
+            if((param < 0) || (param > PING_MAX_PAYLOAD)) { usageFlag = 1; break; }
+            else pingSize = param;
+        }
+        else if(!strcmp(argv[i], "-pingtime"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            int param = atoi(argv[i]);
+            if(param > 0) pingTime = param;
+        }
         else if(!strcmp(argv[i], "-fr"))
         {
             if(++i >= argc) { usageFlag = 1; break; }
@@ -678,6 +2034,155 @@ int main(int argc, char **argv)
         {
             options = (options & ~IDTFOPT_PALETTE_MASK) | IDTFOPT_PALETTE_ILDA_STANDARD;
         }
+        else if(!strcmp(argv[i], "-txtime"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            if(!strcmp(argv[i], "fq")) txTimeClock = PLT_CLOCK_MONOTONIC;
+            else if(!strcmp(argv[i], "etf")) txTimeClock = PLT_CLOCK_TAI;
+            else { usageFlag = 1; break; }
+        }
+        else if(!strcmp(argv[i], "-txengine"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            if(!strcmp(argv[i], "socket")) txEngine = 0;
+            else if(!strcmp(argv[i], "uring")) txEngine = 1;
+            else if(!strcmp(argv[i], "uring-zc")) txEngine = 2;
+            else { usageFlag = 1; break; }
+        }
+        else if(!strcmp(argv[i], "-shape"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            if(shpParseRate(argv[i], &shapeRate, &shapeBurst)) { usageFlag = 1; break; }
+            shapeFlag = 1;
+        }
+        else if(!strcmp(argv[i], "-link"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            if(shpParseRate(argv[i], &linkRate, &linkBurst)) { usageFlag = 1; break; }
+            shapeFlag = 1;
+        }
+        else if(!strcmp(argv[i], "-late"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            if(!strcmp(argv[i], "send")) latePolicy = LATE_POLICY_SEND;
+            else if(!strcmp(argv[i], "skip")) latePolicy = LATE_POLICY_SKIP;
+            else if(!strcmp(argv[i], "catchup")) latePolicy = LATE_POLICY_CATCHUP;
+            else { usageFlag = 1; break; }
+        }
+        else if(!strcmp(argv[i], "-spin"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            int param = atoi(argv[i]);
+            if((param < 0) || (param >= 100000)) { usageFlag = 1; break; }
+            else spinTime = param;
+        }
+        else if(!strcmp(argv[i], "-lookahead"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            int param = atoi(argv[i]);
+            if((param < 0) || (param > FRAMEQUEUE_MAX_DEPTH)) { usageFlag = 1; break; }
+            else { lookahead = param; lookaheadFlag = 1; }
+        }
+        else if(!strcmp(argv[i], "-rtcpu"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            int param = atoi(argv[i]);
+            if((param < 0) || (param >= 1024)) { usageFlag = 1; break; }
+            else rtCpu = param;
+        }
+        else if(!strcmp(argv[i], "-rtprio"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            int param = atoi(argv[i]);
+            if((param < 1) || (param > 99)) { usageFlag = 1; break; }
+            else rtPriority = param;
+        }
+        else if(!strcmp(argv[i], "-mlock"))
+        {
+            mlockFlag = 1;
+        }
+        else if(!strcmp(argv[i], "-rs"))
+        {
+            resampleFlag = 1;
+        }
+        else if(!strcmp(argv[i], "-budget"))
+        {
+            budgetFlag = 1;
+        }
+        else if(!strcmp(argv[i], "-wave"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            int param = atoi(argv[i]);
+            if((param < 1) || (param > 100)) { usageFlag = 1; break; }
+            else waveTime = param;
+        }
+        else if(!strcmp(argv[i], "-sessions"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            sessionsFilename = argv[i];
+        }
+        else if(!strcmp(argv[i], "-script"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            scriptFilename = argv[i];
+        }
+        else if(!strcmp(argv[i], "-head"))
+        {
+            // Head number and target, optionally with service ID: n ipAddress[:serviceID]
+            if((i + 2 >= argc) || (headCnt == MAX_HEADS)) { usageFlag = 1; break; }
+            int param = atoi(argv[++i]);
+            if((param < 0) || (param > 255)) { usageFlag = 1; break; }
+
+            IDN_HEAD_ROUTE *route = &headRoutes[headCnt++];
+            route->headNumber = (uint8_t)param;
+            route->serviceID = -1;
+
+            char *target = argv[++i], *sidPtr = strchr(target, ':');
+            if(sidPtr)
+            {
+                *sidPtr++ = 0;
+                route->serviceID = atoi(sidPtr);
+                if((route->serviceID < 0) || (route->serviceID > 255)) { usageFlag = 1; break; }
+            }
+            route->serverAddr = inet_addr(target);
+            if((route->serverAddr == 0) || (route->serverAddr == INADDR_NONE)) { usageFlag = 1; break; }
+        }
+        else if(!strcmp(argv[i], "-daemon"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            daemonPath = argv[i];
+        }
+        else if(!strcmp(argv[i], "-watch"))
+        {
+            watchFlag = 1;
+        }
+        else if(!strcmp(argv[i], "-sync"))
+        {
+            syncFlag = 1;
+        }
+        else if(!strcmp(argv[i], "-syncshm"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            syncName = argv[i];
+        }
+        else if(!strcmp(argv[i], "-shards"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            int param = atoi(argv[i]);
+            if((param < 0) || (param > WORKPOOL_MAX_WORKERS)) { usageFlag = 1; break; }
+            else shardCnt = param ? param : plt_getCPUCount();
+        }
+        else if(!strcmp(argv[i], "-virt"))
+        {
+            virtualClockFlag = 1;
+        }
+        else if(!strcmp(argv[i], "-txlead"))
+        {
+            if(++i >= argc) { usageFlag = 1; break; }
+            int param = atoi(argv[i]);
+            if((param <= 0) || (param >= 1000000)) { usageFlag = 1; break; }
+            else txLeadTime = param;
+        }
         else
         {
             usageFlag = 1;
@@ -685,7 +2190,8 @@ int main(int argc, char **argv)
         }
     }
 
-    if(usageFlag || !helloServerAddr || !idtfFilename || (frameRate < 5))
+    int probeOnlyFlag = pingCnt && !sessionsFilename && !idtfFilename && !daemonPath && !scriptFilename && !headCnt;
+    if(usageFlag || (!sessionsFilename && !probeOnlyFlag && ((!helloServerAddr && !headCnt) || (!idtfFilename && !daemonPath && !scriptFilename))) || (frameRate < 5))
     {
         printf("\n");
         printf("USAGE: idtfPlayer { Options } \n\n");
@@ -693,16 +2199,53 @@ int main(int argc, char **argv)
         printf("  -hs      ipAddress   IP address of the IDN-Hello server.\n");
         printf("  -cg      clientGroup The client group (0..15, default = 0).\n");
         printf("  -idtf    filename    Name of the IDTF (ILDA Image Data Transfer Format) file.\n");
+        printf("                       Repeat to play a gapless playlist (next file decoded ahead).\n");
         printf("  -hold    time        Time in seconds to display single-frame files\n");
+        printf("  -ka      ms          Keepalive: Void message when no frame for ms (default: 100, 0: off)\n");
+        printf("  -ack     ms          Request an acknowledge every ms (default: off)\n");
         printf("  -fr      frameRate   Number of frames per second. (default: 30)\n");
         printf("  -jf                  Jitter-Free (scan frames only once to match frame rate)\n");
         printf("  -pps     scanSpeed   Number of points/samples per second. (default: 30000)\n");
         printf("  -sft     colorShift  Number of points, the color is shifted (default: 0)\n");
+        printf("  -rs                  Resample frames to exactly fill the frame period (see -jf).\n");
+        printf("  -budget              Reduce frames with more points than -pps allows for -fr.\n");
         printf("  -scale   factor      Factor by which to scale the IDTF file (default: 1.0)\n");
         printf("  -mx                  Mirror x axis\n");
         printf("  -my                  Mirror y axis\n");
         printf("  -def-pal             Use the default palette as of IDTF rev. 11 (default).\n");
         printf("  -std-pal             Use the abandoned ILDA Standard Palette.\n");
+        printf("  -late    policy      Late frames: 'send' (default, shift schedule), 'skip' or 'catchup'.\n");
+        printf("  -spin    time        Busy-wait the last microseconds before a frame deadline.\n");
+        printf("  -lookahead frames    Frames decoded ahead by a separate thread (default: 4, 0: off)\n");
+        printf("  -rtcpu   cpu         Pin the sender thread to the given CPU core.\n");
+        printf("  -rtprio  priority    Run the sender thread SCHED_FIFO with the given priority (1..99).\n");
+        printf("  -mlock               Lock memory, prefault buffers and stack (no page faults).\n");
+        printf("  -wave    time        Continuous waveform in chunks of the given milliseconds (low latency).\n");
+        printf("  -virt                Virtual clock: Send as fast as possible, same timestamps.\n");
+        printf("  -sessions filename   Play many sessions from one thread, one line of options each\n");
+        printf("                       (-hs, -idtf or -script, -cg, -sid, -fr, -pps, -sft, -hold, -scale, -mx, -my).\n");
+        printf("  -script  filename    Run a show script: play file [for s | times n | until cue | loop],\n");
+        printf("                       wait s, await cue, cue name, stop, repeat (one per line).\n");
+        printf("  -head    n ip[:sid]  Play the frames of head n (ILDA head number) to the given server,\n");
+        printf("                       once per head. File decoded once, heads paced in parallel.\n");
+        printf("  -daemon  path        Keep running, commands on a local socket: load/play/switch file,\n");
+        printf("                       seek frame, stop, status, quit (one per line).\n");
+        printf("  -watch               Reload the show when the file changes (hot reload, no restart). Note:\n");
+        printf("                       Runs as a daemon, the show loops until stopped (not played once),\n");
+        printf("                       no playlist, -lookahead, -wave, -txtime or -txengine.\n");
+        printf("  -sync                Common timeline for -sessions/-head: Same deadline and timestamp per frame.\n");
+        printf("  -syncshm name        Common timeline shared with other processes (shared memory).\n");
+        printf("  -shards  count       Event loop threads for -sessions/-head, one per core (default: 1, 0: all cores)\n");
+        printf("  -txtime  qdisc       Kernel-paced transmission (SO_TXTIME), qdisc 'fq' or 'etf'.\n");
+        printf("  -txlead  time        Wake-up lead time in microseconds for -txtime (default: 1000)\n");
+        printf("  -txengine engine     Transmit engine 'socket' (default), 'uring' or 'uring-zc'.\n");
+        printf("  -shape   rate[:burst] Shape the stream to rate Mbit/s, burst in bytes.\n");
+        printf("  -link    rate[:burst] Uplink rate Mbit/s (fair-shared by the streams), burst in bytes.\n");
+        printf("  -ping    ipAddress   Probe the round trip to the unit (IDN-Hello ping), repeat for several units.\n");
+        printf("                       Alone for -pingtime, otherwise alongside the stream (own socket and thread).\n");
+        printf("  -pingrate rate       Pings per second and unit (default: 10)\n");
+        printf("  -pingsize bytes      Payload bytes per ping (default: 16, max: 1400)\n");
+        printf("  -pingtime time       Time in seconds to probe without a stream (default: 10)\n");
         printf("\n");
 
         return 0;
@@ -711,81 +2254,473 @@ int main(int argc, char **argv)
 
     // -------------------------------------------------------------------------
 
-    printf("Connecting to IDN-Hello server at %s\n", inet_ntoa(*(struct in_addr *)&helloServerAddr));
+    if(probeOnlyFlag) printf("Probing %u unit%s, %u pings per second\n", pingCnt, (pingCnt == 1) ? "" : "s", pingRate);
+    else if(sessionsFilename) printf("Running the sessions of %s\n", sessionsFilename);
+    else if(scriptFilename && !daemonPath && !watchFlag) printf("Running show script %s\n", scriptFilename);
+    else if(daemonPath) printf("Daemon for IDN-Hello server at %s\n", inet_ntoa(*(struct in_addr *)&helloServerAddr));
+    else if(watchFlag) printf("Looping %s to IDN-Hello server at %s until stopped, reloaded when changed\n", idtfFilename, inet_ntoa(*(struct in_addr *)&helloServerAddr));
+    else if(headCnt) printf("Playing %u heads of %s\n", headCnt, idtfFilename);
+    else if(playlistCnt > 1) printf("Playing %u files to IDN-Hello server at %s\n", playlistCnt, inet_ntoa(*(struct in_addr *)&helloServerAddr));
+    else printf("Connecting to IDN-Hello server at %s\n", inet_ntoa(*(struct in_addr *)&helloServerAddr));
     printf("Press Ctrl-C to stop\n");
 
     // Initialize driver function context
     IDNCONTEXT ctx = { 0 };
+    uint64_t wallStartTime = plt_readMonoClockNS();
     ctx.fdSocket = -1;
     ctx.serverSockAddr.sin_family = AF_INET;
     ctx.serverSockAddr.sin_port = htons(IDNVAL_HELLO_UDP_PORT);
     ctx.serverSockAddr.sin_addr.s_addr = helloServerAddr;
     ctx.clientGroup = clientGroup;
     ctx.serviceID = serviceID;
+    ctx.serviceMode = IDNVAL_SMOD_LPGRF_DISCRETE;
+    ctx.frameRate = frameRate;
     ctx.usFrameTime = 1000000 / frameRate;
+    ctx.latePolicy = latePolicy;
+    ctx.spinTime = spinTime;
+    ctx.keepaliveNS = (uint64_t)keepaliveTime * 1000000;
+    ctx.ackIntervalNS = (uint64_t)ackInterval * 1000000;
     ctx.jitterFreeFlag = jitterFreeFlag;
     ctx.scanSpeed = scanSpeed;
     ctx.colorShift = colorShift;
+    ctx.txTimeClock = txTimeClock;
+    ctx.txLeadTime = txLeadTime;
+    ctx.txProbeFrames = TXTIME_PROBE_FRAMES;
+
+    // Initialize traffic shaping (target bucket attached to the uplink bucket)
+    shpInitLink(&linkShaper, linkRate, linkBurst);
+    shpInitStream(&ctx.shaper, &linkShaper, shapeRate, shapeBurst);
+    ctx.shapeFlag = shapeFlag;
     
     do
     {
         // Validate monotonic time reference
         if(plt_validateMonoTime() != 0)
         {
-            logError("Monotonic time init failed");
+            idnLogError("Monotonic time init failed");
             return -1;
         }
 
+        // Virtual clock: Time advances by sleeping only (instantly), no kernel pacing
+        if(virtualClockFlag)
+        {
+            plt_enableVirtualClock();
+            if(ctx.txTimeClock >= 0)
+            {
+                idnLogError("[IDN] Kernel pacing not supported with the virtual clock, -txtime ignored");
+                ctx.txTimeClock = -1;
+            }
+        }
+
+        // Sessions/heads: One socket shared by all streams
+        if((sessionsFilename || scriptFilename) && headCnt)
+        {
+            idnLogError("[SSN] -head not supported with -sessions/-script, ignored");
+            headCnt = 0;
+        }
+        if((sessionsFilename || headCnt) && (daemonPath || watchFlag))
+        {
+            idnLogError("[SSN] -daemon and -watch not supported with -sessions/-head, ignored");
+            daemonPath = 0;
+            watchFlag = 0;
+        }
+        if(scriptFilename && (daemonPath || watchFlag))
+        {
+            idnLogError("[SSN] -script not supported with -daemon/-watch, ignored");
+            scriptFilename = 0;
+        }
+        // Note: Modes other than the single stream name the option dropped (-watch runs as a daemon)
+        const char *modeName = sessionsFilename ? "-sessions" : scriptFilename ? "-script" : headCnt ? "-head" :
+                               daemonPath ? "-daemon" : "-watch";
+        if((sessionsFilename || scriptFilename || headCnt || daemonPath || watchFlag) && (txEngine || (ctx.txTimeClock >= 0) || waveTime))
+        {
+            idnLogError("[SSN] -txengine, -txtime and -wave not supported with %s, ignored", modeName);
+            txEngine = 0;
+            ctx.txTimeClock = -1;
+            waveTime = 0;
+        }
+        if((sessionsFilename || scriptFilename || headCnt || daemonPath || watchFlag) && (playlistCnt > 1))
+        {
+            idnLogError("[SSN] Playlist not supported with %s, playing %s only", modeName, idtfFilename);
+            playlistCnt = 1;
+        }
+        if((daemonPath || watchFlag) && lookaheadFlag)
+        {
+            idnLogError("[SSN] -lookahead not supported with %s (shows decoded up front), ignored", modeName);
+        }
+        if(sessionsFilename || scriptFilename || headCnt || daemonPath || watchFlag)
+        {
+            // Event loop: Waits handed back to the loop (timers re-armed), busy-waiting would stall the others
+            if(ctx.spinTime) idnLogError("[SSN] -spin not supported with %s, ignored", modeName);
+            ctx.spinTime = 0;
+            ctx.loopFlag = 1;
+        }
+
+        // Several shards: Threads pinned per core, no common link bucket (not thread-safe)
+        if((sessionsFilename || scriptFilename || headCnt) && (shardCnt > 1))
+        {
+            if(virtualClockFlag)
+            {
+                idnLogError("[SSN] Several shards not supported with the virtual clock, -shards ignored");
+                shardCnt = 1;
+            }
+            else if(linkRate)
+            {
+                idnLogError("[SSN] Link shaping not supported with several shards, -link ignored");
+                shpInitLink(&linkShaper, 0, 0);
+            }
+        }
+
+        // Common timeline: Frame k of all targets at epoch + k * period, late frames dropped (no
+        // shift of the schedule). Note: Virtual time is not common to processes.
+        if((syncFlag || syncName) && waveTime)
+        {
+            idnLogError("[IDN] -sync/-syncshm not supported with -wave, ignored");
+            syncFlag = 0;
+            syncName = 0;
+        }
+        if(syncName && virtualClockFlag)
+        {
+            idnLogError("[IDN] -syncshm not supported with the virtual clock, using a local timeline");
+            syncFlag = 1;
+            syncName = 0;
+        }
+        if(syncFlag || syncName)
+        {
+            uint64_t startDelay = (uint64_t)SYNC_START_DELAY * 1000000;
+            ctx.timeline = syncName ? tmlAttach(syncName, frameRate, startDelay) : tmlCreate(frameRate, startDelay);
+            if(!ctx.timeline) break;
+            ctx.latePolicy = LATE_POLICY_SKIP;
+        }
+
+        // Continuous waveform: Fixed-duration chunks, color shift as a delay line across frames
+        if(waveTime)
+        {
+            unsigned maxLen = (MAX_IDN_MESSAGE_LEN - (FRAME_HEADROOM - sizeof(IDNHDR_PACKET)) - sizeof(IDNHDR_SAMPLE_CHUNK)) / XYRGB_SAMPLE_SIZE;
+            unsigned chunkLen = (unsigned)(((uint64_t)scanSpeed * waveTime) / 1000);
+            if(chunkLen < 1) chunkLen = 1;
+            if(chunkLen > maxLen) chunkLen = maxLen;
+
+            ctx.serviceMode = IDNVAL_SMOD_LPGRF_CONTINUOUS;
+            ctx.waveChunkLen = chunkLen;
+            ctx.waveShift = ctx.colorShift;
+            ctx.colorShift = 0;
+            ctx.waveBufferPtr = (uint8_t *)malloc(FRAME_HEADROOM + sizeof(IDNHDR_SAMPLE_CHUNK) + (chunkLen * XYRGB_SAMPLE_SIZE));
+            if(ctx.waveShift) ctx.waveColorLine = (uint8_t *)calloc(ctx.waveShift, 3);
+            if(!ctx.waveBufferPtr || (ctx.waveShift && !ctx.waveColorLine))
+            {
+                idnLogError("[IDN] Insufficient buffer memory");
+                break;
+            }
+        }
+
+        // Resampling/point budget: Color shift applied to the processed frame
+        if(resampleFlag || budgetFlag)
+        {
+            ctx.resampleFlag = resampleFlag;
+            ctx.budgetFlag = budgetFlag;
+            ctx.processShift = ctx.colorShift;
+            ctx.colorShift = 0;
+        }
+
         // Initialize platform sockets
         int rcStartup = plt_sockStartup();
         if(rcStartup)
         {
-            logError("Socket startup failed. error = %d", rcStartup);
+            idnLogError("Socket startup failed. error = %d", rcStartup);
             break;
         }
 
+        // Latency probe: Own socket and thread with the normal scheduling settings (created before
+        // the real-time setup), the stream is not touched
+        if(pingCnt)
+        {
+            probe = prbCreate(pingAddrs, pingCnt, pingRate, pingSize, clientGroup);
+            if(!probe) break;
+            if(probeOnlyFlag)
+            {
+                prbRun(probe, (uint64_t)pingTime * 1000000000ull);
+                break;
+            }
+            if(prbStart(probe, 0)) break;
+        }
+
         // Open UDP socket
         ctx.fdSocket = plt_sockOpen(AF_INET, SOCK_DGRAM, 0);
         if(ctx.fdSocket < 0)
         {
-            logError("socket() faile (error: %d)", plt_sockGetLastError());
+            idnLogError("socket() faile (error: %d)", plt_sockGetLastError());
+            break;
+        }
+
+        // Asynchronous send engine (io_uring), fall back to regular sendto() calls
+        if(txEngine)
+        {
+            if(ctx.txTimeClock >= 0)
+            {
+                idnLogError("[IDN] Kernel pacing not supported with the io_uring engine, -txtime ignored");
+                ctx.txTimeClock = -1;
+            }
+
+            ctx.txRing = txuOpen(ctx.fdSocket, TXURING_DEFAULT_SLOTS, txEngine == 2);
+            if(ctx.txRing && connect(ctx.fdSocket, (struct sockaddr *)&ctx.serverSockAddr, sizeof(ctx.serverSockAddr)) < 0)
+            {
+                idnLogError("connect() failed (error: %d)", plt_sockGetLastError());
+                txuClose(ctx.txRing);
+                ctx.txRing = (TXURING *)0;
+            }
+            if(!ctx.txRing) idnLogError("[IDN] io_uring engine not available. Using sendto().");
+        }
+
+        // Enable kernel pacing (launch time per datagram), fall back to user-space pacing
+        if((ctx.txTimeClock >= 0) && plt_sockEnableTxTime(ctx.fdSocket, ctx.txTimeClock))
+        {
+            idnLogError("[IDN] SO_TXTIME not available (error: %d). Using user-space pacing.", plt_sockGetLastError());
+            ctx.txTimeClock = -1;
+        }
+
+        // Daemon: One stream kept open, shows switched by commands or reloaded on change
+        if(daemonPath || watchFlag)
+        {
+            setupRealtime(rtCpu, rtPriority, 0);
+            idnRunDaemon(&ctx, daemonPath, idtfFilename, xyScale, options, watchFlag);
             break;
         }
 
+        // Sessions/heads/script: Settings from the command line are the defaults of each session
+        if(sessionsFilename || scriptFilename || headCnt)
+        {
+            IDN_SESSION tmpl;
+            memset(&tmpl, 0, sizeof(tmpl));
+            tmpl.ctx = ctx;
+            tmpl.idtfFilename = idtfFilename;
+            tmpl.xyScale = xyScale;
+            tmpl.options = options;
+            tmpl.holdTime = holdTime;
+            tmpl.headNumber = -1;
+            tmpl.scriptFilename = scriptFilename;
+
+            // Decode upfront: Each session file on its own, all heads in one pass
+            unsigned sessionCnt = headCnt;
+            IDN_SESSION *sessions = (IDN_SESSION *)0;
+            if(sessionsFilename) sessions = idnLoadSessions(sessionsFilename, &tmpl, &sessionCnt);
+            else if(scriptFilename) sessions = idnLoadScriptSession(&tmpl, &sessionCnt);
+            else sessions = idnLoadHeads(headRoutes, headCnt, &tmpl);
+            if(!sessions) break;
+            int rcSync = 0;
+            for(unsigned i = 0; ctx.timeline && (i < sessionCnt); i++)
+            {
+                if(sessions[i].ctx.frameRate == frameRate) continue;
+
+                idnLogError("[SSN] Session %u: Frame rate differs from the common timeline (%u)", i + 1, frameRate);
+                rcSync = -1;
+            }
+            if(rcSync || idnConnectSessions(sessions, sessionCnt))
+            {
+                idnFreeSessions(sessions, sessionCnt);
+                break;
+            }
+
+            int rcDecode = headCnt ? idnDecodeHeads(sessions, sessionCnt) : idnDecodeSessions(sessions, sessionCnt, shardCnt);
+            if(rcDecode)
+            {
+                idnFreeSessions(sessions, sessionCnt);
+                break;
+            }
+
+            if(shardCnt == 1) setupRealtime(rtCpu, rtPriority, 0);
+            idnRunSessions(sessions, sessionCnt, &tmpl, shardCnt, rtCpu, rtPriority);
+            break;
+        }
+
+        // Single stream: Acknowledges taken from the socket while waiting for the deadlines
+        ctx.ackPollFlag = 1;
+
         // Initialize IDTF reader callback function table
         IDTF_CALLBACK_FUNC cbFunc = { 0 };
         cbFunc.openFrame = idnOpenFrameXYRGB;
         cbFunc.putSampleXYRGB = idnPutSampleXYRGB;
         cbFunc.pushFrame = idnPushFrameXYRGB;
         
+        // Decode ahead in a separate thread, fall back to sending inline
+        if(lookahead)
+        {
+            ctx.frameQueue = frqCreate(lookahead);
+            if(!ctx.frameQueue) idnLogError("[IDN] Frame queue allocation failed. Decoding inline.");
+        }
+
+        // Lock all pages, allocate and touch the work buffers ahead (no page faults while sending)
+        if(mlockFlag)
+        {
+            int rcLock = plt_lockMemory();
+            if(rcLock) idnLogError("[IDN] Real-time: Memory locking failed (error: %d), page faults possible", rcLock);
+            else idnLogInfo("[IDN] Real-time: Memory locked");
+
+            if(idnEnsureBuffer(&ctx, PREFAULT_BUFFER_SIZE)) break;
+            memset(ctx.bufferPtr, 0, ctx.bufferLen);
+            if(ctx.frameQueue && frqReserve(ctx.frameQueue, PREFAULT_BUFFER_SIZE)) idnLogError("[IDN] Frame buffer allocation failed");
+        }
+
         // Run IDTF reader
-        ctx.startTime = plt_getMonoTimeUS();
-        if(idtfRead(idtfFilename, xyScale, options, &cbFunc, &ctx)) break;
+        DECODER_TASK decoderTask = { playlist, playlistCnt, holdTime, xyScale, options, &cbFunc, &ctx, 0 };
+        ctx.startTime = plt_getMonoTimeNS();
+        wallStartTime = plt_readMonoClockNS();
+        if(ctx.frameQueue)
+        {
+            // Decoder thread fills the queue, this thread paces and sends the frames
+            PLT_THREAD decoderThread;
+            if(plt_threadCreate(&decoderThread, idnDecoderThread, &decoderTask))
+            {
+                idnLogError("[IDN] Decoder thread creation failed");
+                break;
+            }
+
+            // Note: The decoder thread keeps the normal scheduling settings
+            setupRealtime(rtCpu, rtPriority, mlockFlag);
+            int rcSender = idnRunSender(&ctx);
+            plt_threadJoin(decoderThread);
+            if(rcSender || decoderTask.rc) break;
+        }
+        else
+        {
+            setupRealtime(rtCpu, rtPriority, mlockFlag);
+            if(idnReadPlaylist(&decoderTask)) break;
+        }
 
         // Check for single frame IDTF file.(wait for the passed hold time)
-        if(ctx.frameCnt == 1) 
+        if((ctx.frameCnt == 1) && ctx.waveChunkLen)
         {
-            // Wait
-            for(unsigned i = 0; i < holdTime * 10; i++) 
+            // Continuous waveform: Keep scanning the frame
+            for(unsigned i = 0; i < holdTime * ctx.frameRate; i++)
             {
-                plt_usleep(100000);
-                idnSendVoid(&ctx);
+                if(idnSendWave(&ctx, ctx.waveHoldPtr, ctx.waveHoldCnt)) break;
             }
         }
+        else if(ctx.frameCnt == 1) 
+        {
+            // Wait (keepalive messages meanwhile)
+            uint64_t holdEnd = plt_getMonoTimeNS() + ((uint64_t)holdTime * 1000000000ull);
+            idnKeepalive(&ctx, holdEnd);
+            plt_sleepUntilNS(holdEnd);
+        }
 
-        // Close the IDN channel
+        // Close the IDN channel (send the remaining samples first)
+        if(ctx.waveChunkLen) idnFlushWave(&ctx);
         idnSendClose(&ctx);
     }
     while(0);
+    uint64_t wallTime = plt_readMonoClockNS() - wallStartTime;
+
+    // Stop the probe (responses still in time taken), round trip report
+    if(probe)
+    {
+        prbStop(probe);
+        prbReport(probe);
+        prbDestroy(probe);
+    }
+
+    // Wait for datagrams in flight, report send engine statistics
+    if(ctx.txRing)
+    {
+        TXURING_STATS stats;
+        txuFlush(ctx.txRing);
+        txuGetStats(ctx.txRing, &stats);
+        txuClose(ctx.txRing);
+        idnLogInfo("[IDN] io_uring%s: %llu datagrams, %llu submits, %u max in flight, %llu errors",
+                   stats.zeroCopy ? " (zero-copy)" : "", (unsigned long long)stats.sendCnt,
+                   (unsigned long long)stats.submitCnt, stats.inFlightMax, (unsigned long long)stats.errorCnt);
+    }
+
+    // Report frame pacing
+    if(ctx.waveChunkCnt)
+    {
+        idnLogInfo("[IDN] Wave: %u frames, %u chunks of %u samples, lateness avg %d us, max %d us, %u late",
+                   ctx.frameCnt, ctx.waveChunkCnt, ctx.waveChunkLen, (int)(ctx.latenessSum / ctx.waveChunkCnt),
+                   ctx.latenessMax, ctx.lateCnt);
+    }
+    else if(ctx.frameCnt)
+    {
+        idnLogInfo("[IDN] Pacing: %u frames, lateness avg %d us, max %d us, %u late, %u skipped",
+                   ctx.frameCnt, (int)(ctx.latenessSum / ctx.frameCnt), ctx.latenessMax, ctx.lateCnt, ctx.skipCnt);
+    }
+    if(ctx.jitterCnt)
+    {
+        idnLogInfo("[IDN] Jitter: %u intervals, deviation from frame period avg %d us, max %d us",
+                   ctx.jitterCnt, (int)(ctx.jitterSum / ctx.jitterCnt), ctx.jitterMax);
+    }
+    if(ctx.voidCnt)
+    {
+        idnLogInfo("[IDN] Keepalive: %u void messages", ctx.voidCnt);
+    }
+    idnReportAck(&ctx, "[IDN]");
+
+    // Report point budget
+    if(ctx.budgetFlag && !ctx.resampleFlag)
+    {
+        idnLogInfo("[IDN] Point budget: %u samples/frame, %u of %u frames reduced (%llu samples removed, max %u), %u over budget",
+                   (ctx.scanSpeed / ctx.frameRate) + 1, ctx.reduceCnt, ctx.decodeCnt, (unsigned long long)ctx.reduceSum,
+                   ctx.reduceMax, ctx.overBudgetCnt);
+    }
+
+    // Report decoder/sender pipeline
+    if(ctx.frameQueue)
+    {
+        FRAME_QUEUE_STATS stats;
+        frqGetStats(ctx.frameQueue, &stats);
+        frqDestroy(ctx.frameQueue);
+        idnLogInfo("[IDN] Frame queue: depth %u, occupancy avg %.1f, min %u, %u underruns, %u decoder waits",
+                   stats.depth, stats.getCnt ? (double)stats.occupancySum / (double)stats.getCnt : 0.0,
+                   stats.occupancyMin, stats.underrunCnt, stats.fullCnt);
+    }
+
+    // Report throughput (stream time vs. wall clock time)
+    if(virtualClockFlag && wallTime)
+    {
+        double wallSec = (double)wallTime / 1e9;
+        idnLogInfo("[IDN] Virtual clock: %.3f s stream time in %.3f s (x%.1f), %.0f frames/s, %.0f samples/s, %.1f Mbit/s",
+                   (double)(plt_getMonoTimeNS() - ctx.startTime) / 1e9, wallSec,
+                   (double)(plt_getMonoTimeNS() - ctx.startTime) / (double)wallTime,
+                   (double)ctx.frameCnt / wallSec, (double)ctx.decodeSampleCnt / wallSec,
+                   (double)ctx.byteCnt * 8.0 / wallSec / 1e6);
+    }
+
+    // Report traffic shaping
+    if(ctx.shapeFlag && !sessionsFilename && !scriptFilename && !headCnt)
+    {
+        SHAPER_STREAM *shp = &ctx.shaper;
+        idnLogInfo("[IDN] Shaper: %llu bytes, %llu datagrams delayed (avg %u us, max %u us)",
+                   (unsigned long long)shp->byteCnt, (unsigned long long)shp->delayedCnt,
+                   shp->delayedCnt ? (unsigned)(shp->delaySum / shp->delayedCnt / 1000) : 0, (unsigned)(shp->delayMax / 1000));
+    }
+    shpDetachStream(&ctx.shaper);
+
+    // Report the skew of the targets on the common timeline
+    if(ctx.timeline)
+    {
+        TIMELINE_STATS stats;
+        tmlGetStats(ctx.timeline, &stats);
+        idnLogInfo("[IDN] Sync: %u targets, %llu frames compared, skew avg %u us, max %u us%s",
+                   stats.targetMax, (unsigned long long)stats.frameCnt,
+                   stats.frameCnt ? (unsigned)(stats.skewSum / stats.frameCnt / 1000) : 0, (unsigned)(stats.skewMax / 1000),
+                   syncName ? " (all processes)" : "");
+        tmlClose(ctx.timeline);
+    }
 
     // Free buffer memory
+    scrFreeCues(&scriptCues);
     if(ctx.bufferPtr) free(ctx.bufferPtr);
+    if(ctx.waveBufferPtr) free(ctx.waveBufferPtr);
+    if(ctx.waveColorLine) free(ctx.waveColorLine);
+    if(ctx.waveHoldPtr) free(ctx.waveHoldPtr);
+    if(ctx.holdFramePtr) free(ctx.holdFramePtr);
+    frmFree(&ctx.processSource);
+    frmFree(&ctx.processTarget);
 
     // Close socket
     if(ctx.fdSocket >= 0) plt_sockClose(ctx.fdSocket);
 
     // Platform sockets cleanup
-    if(plt_sockCleanup()) logError("Socket cleanup failed (error: %d)", plt_sockGetLastError());
+    if(plt_sockCleanup()) idnLogError("Socket cleanup failed (error: %d)", plt_sockGetLastError());
 
     return 0;
 }
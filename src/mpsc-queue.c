@@ -0,0 +1,276 @@
+// -------------------------------------------------------------------------------------------------
+//  File mpsc-queue.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+// Platform includes
+#if defined(_WIN32) || defined(WIN32)
+
+    #include <windows.h>
+
+    #include "plt-windows.h"
+
+#else
+
+    #include "plt-posix.h"
+
+#endif
+
+
+// Module header
+#include "mpsc-queue.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    FRAME_QUEUE_SLOT slot;                  // Frame buffer (swapped on commit)
+    volatile uint32_t sequence;             // Ticket the slot is free for, ticket + 1: committed
+    uint8_t padding[32];                    // One cache line per slot (producers fill them concurrently)
+
+} MPSC_CELL;
+
+
+struct _MPSC_QUEUE
+{
+    unsigned depth;                         // Number of slots (power of two)
+    MPSC_CELL *cells;                       // Slot array
+
+    // Next ticket, shared by the producers (own cache line, the consumer side stays local)
+    uint8_t padding0[64];
+    volatile uint32_t enqueuePos;
+    uint8_t padding1[64];
+
+    // Consumer side
+    uint32_t dequeuePos;                    // Ticket of the next slot to take
+    volatile uint32_t closedFlag;           // No more frames (producers done)
+    volatile uint32_t abortFlag;            // Consumer done, refuse further reservations
+
+    // Sleeping (only when the next slot is not committed). Note: The lock is not used to pass frames.
+    volatile uint32_t consumerWaiting;      // Consumer sleeps on dataCond
+    PLT_MUTEX mutex;
+    PLT_COND dataCond;
+
+    // Statistics. Note: Producer counters are only touched when contended or full.
+    volatile uint32_t fullCnt;
+    volatile uint32_t retryCnt;
+    uint64_t getCnt;
+    uint32_t stallCnt;
+
+};
+
+
+// -------------------------------------------------------------------------------------------------
+//  Tools
+// -------------------------------------------------------------------------------------------------
+
+static void wakeUp(MPSC_QUEUE *mpq)
+{
+    // Note: The sequence store (by the caller) and the flag check are sequentially consistent,
+    // see frame-queue.c
+    if(plt_atomicLoad32(&mpq->consumerWaiting))
+    {
+        plt_mutexLock(&mpq->mutex);
+        plt_condSignal(&mpq->dataCond);
+        plt_mutexUnlock(&mpq->mutex);
+    }
+}
+
+
+static int isCommitted(MPSC_QUEUE *mpq)
+{
+    MPSC_CELL *cell = &mpq->cells[mpq->dequeuePos & (mpq->depth - 1)];
+
+    return plt_atomicLoad32(&cell->sequence) == mpq->dequeuePos + 1;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  API functions
+// -------------------------------------------------------------------------------------------------
+
+MPSC_QUEUE *mpqCreate(unsigned depth)
+{
+    // Power of two: Slot index stays continuous when the tickets wrap around
+    unsigned size = 1;
+    while((size < depth) && (size < MPSCQUEUE_MAX_DEPTH)) size <<= 1;
+
+    MPSC_QUEUE *mpq = (MPSC_QUEUE *)calloc(1, sizeof(MPSC_QUEUE));
+    if(!mpq) return (MPSC_QUEUE *)0;
+
+    mpq->cells = (MPSC_CELL *)calloc(size, sizeof(MPSC_CELL));
+    if(!mpq->cells) { free(mpq); return (MPSC_QUEUE *)0; }
+
+    mpq->depth = size;
+    for(unsigned i = 0; i < size; i++) mpq->cells[i].sequence = i;
+    plt_mutexInit(&mpq->mutex);
+    plt_condInit(&mpq->dataCond);
+
+    return mpq;
+}
+
+
+void mpqDestroy(MPSC_QUEUE *mpq)
+{
+    if(!mpq) return;
+
+    for(unsigned i = 0; i < mpq->depth; i++)
+    {
+        if(mpq->cells[i].slot.bufferPtr) free(mpq->cells[i].slot.bufferPtr);
+    }
+
+    plt_condDestroy(&mpq->dataCond);
+    plt_mutexDestroy(&mpq->mutex);
+    free(mpq->cells);
+    free(mpq);
+}
+
+
+FRAME_QUEUE_SLOT *mpqReserve(MPSC_QUEUE *mpq, uint32_t *ticketPtr, int *fullPtr)
+{
+    *fullPtr = 0;
+
+    uint32_t pos = plt_atomicLoad32(&mpq->enqueuePos);
+    while(!plt_atomicLoad32(&mpq->abortFlag))
+    {
+        MPSC_CELL *cell = &mpq->cells[pos & (mpq->depth - 1)];
+        int32_t diff = (int32_t)(plt_atomicLoad32(&cell->sequence) - pos);
+        if(diff == 0)
+        {
+            // Slot free for this ticket: Take the ticket (other producers may be faster)
+            if(plt_atomicCompareExchange32(&mpq->enqueuePos, pos, pos + 1))
+            {
+                *ticketPtr = pos;
+                return &cell->slot;
+            }
+            plt_atomicAdd32(&mpq->retryCnt, 1);
+        }
+        else if(diff < 0)
+        {
+            // Slot of the previous round not taken by the consumer yet
+            plt_atomicAdd32(&mpq->fullCnt, 1);
+            *fullPtr = 1;
+            break;
+        }
+
+        pos = plt_atomicLoad32(&mpq->enqueuePos);
+    }
+
+    return (FRAME_QUEUE_SLOT *)0;
+}
+
+
+void mpqCommit(MPSC_QUEUE *mpq, uint32_t ticket)
+{
+    // Publish the slot (all slot writes happen before the sequence store)
+    MPSC_CELL *cell = &mpq->cells[ticket & (mpq->depth - 1)];
+    plt_atomicStore32(&cell->sequence, ticket + 1);
+
+    wakeUp(mpq);
+}
+
+
+void mpqClose(MPSC_QUEUE *mpq)
+{
+    // Note: Slots reserved but not committed at this point are dropped
+    plt_atomicStore32(&mpq->closedFlag, 1);
+    wakeUp(mpq);
+}
+
+
+FRAME_QUEUE_SLOT *mpqGetBeginUntil(MPSC_QUEUE *mpq, uint64_t nsDeadline, int *timeoutPtr)
+{
+    if(timeoutPtr) *timeoutPtr = 0;
+
+    // Wait for the next slot in ticket order
+    if(!isCommitted(mpq))
+    {
+        // Head of line: Reserved, but still being filled (later slots may be committed already)
+        if(plt_atomicLoad32(&mpq->enqueuePos) != mpq->dequeuePos) mpq->stallCnt++;
+
+        int timeoutFlag = 0;
+        plt_mutexLock(&mpq->mutex);
+        plt_atomicStore32(&mpq->consumerWaiting, 1);
+        while(!isCommitted(mpq) && !plt_atomicLoad32(&mpq->closedFlag) && !timeoutFlag)
+        {
+            if(!nsDeadline) plt_condWait(&mpq->dataCond, &mpq->mutex);
+            else timeoutFlag = plt_condWaitUntilNS(&mpq->dataCond, &mpq->mutex, nsDeadline);
+        }
+        plt_atomicStore32(&mpq->consumerWaiting, 0);
+        plt_mutexUnlock(&mpq->mutex);
+
+        // Note: The producers commit before the queue is closed
+        if(!isCommitted(mpq))
+        {
+            if(timeoutPtr && !plt_atomicLoad32(&mpq->closedFlag)) *timeoutPtr = timeoutFlag;
+            return (FRAME_QUEUE_SLOT *)0;
+        }
+    }
+
+    return &mpq->cells[mpq->dequeuePos & (mpq->depth - 1)].slot;
+}
+
+
+void mpqGetEnd(MPSC_QUEUE *mpq)
+{
+    // Release the slot for the ticket of the next round
+    MPSC_CELL *cell = &mpq->cells[mpq->dequeuePos & (mpq->depth - 1)];
+    plt_atomicStore32(&cell->sequence, mpq->dequeuePos + mpq->depth);
+    mpq->dequeuePos++;
+    mpq->getCnt++;
+}
+
+
+void mpqAbort(MPSC_QUEUE *mpq)
+{
+    plt_atomicStore32(&mpq->abortFlag, 1);
+}
+
+
+void mpqGetStats(MPSC_QUEUE *mpq, MPSC_QUEUE_STATS *stats)
+{
+    memset(stats, 0, sizeof(MPSC_QUEUE_STATS));
+
+    // Note: Tickets are free running, counted since the start (32 bit)
+    stats->reserveCnt = plt_atomicLoad32(&mpq->enqueuePos);
+    stats->getCnt = mpq->getCnt;
+    stats->fullCnt = plt_atomicLoad32(&mpq->fullCnt);
+    stats->retryCnt = plt_atomicLoad32(&mpq->retryCnt);
+    stats->stallCnt = mpq->stallCnt;
+    stats->depth = mpq->depth;
+}
@@ -0,0 +1,90 @@
+// -------------------------------------------------------------------------------------------------
+//  File mpsc-queue.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// Project headers
+#include "frame-queue.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define MPSCQUEUE_MAX_DEPTH             256         // Depth is rounded up to a power of two
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct _MPSC_QUEUE MPSC_QUEUE;
+
+typedef struct
+{
+    uint64_t reserveCnt;                    // Number of slots reserved by the producers
+    uint64_t getCnt;                        // Number of frames taken by the consumer
+    uint32_t fullCnt;                       // Number of reservations refused (queue full)
+    uint32_t retryCnt;                      // Number of reservations retried (lost to another producer)
+    uint32_t stallCnt;                      // Consumer waited for a reserved slot not committed yet
+    unsigned depth;                         // Queue capacity
+
+} MPSC_QUEUE_STATS;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+// Note: Several producers, single consumer (bounded ring, per-slot sequence numbers). A producer
+// reserves a slot with one compare-and-swap, fills it and commits it with one store, no lock and
+// no waiting. The reservation ticket is the position in the output: The consumer takes the slots
+// in ticket order and sleeps only when the next one is not committed yet.
+MPSC_QUEUE *mpqCreate(unsigned depth);
+void mpqDestroy(MPSC_QUEUE *mpq);
+
+FRAME_QUEUE_SLOT *mpqReserve(MPSC_QUEUE *mpq, uint32_t *ticketPtr, int *fullPtr);
+void mpqCommit(MPSC_QUEUE *mpq, uint32_t ticket);
+void mpqClose(MPSC_QUEUE *mpq);
+
+FRAME_QUEUE_SLOT *mpqGetBeginUntil(MPSC_QUEUE *mpq, uint64_t nsDeadline, int *timeoutPtr);
+void mpqGetEnd(MPSC_QUEUE *mpq);
+void mpqAbort(MPSC_QUEUE *mpq);
+
+void mpqGetStats(MPSC_QUEUE *mpq, MPSC_QUEUE_STATS *stats);
+
+
+#endif
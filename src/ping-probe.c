@@ -0,0 +1,432 @@
+// -------------------------------------------------------------------------------------------------
+//  File ping-probe.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Platform includes
+#if defined(_WIN32) || defined(WIN32)
+#include "plt-windows.h"
+#else
+#include <arpa/inet.h>
+#include "plt-posix.h"
+#endif
+
+// Project headers
+#include "idn-hello.h"
+
+// Module header
+#include "ping-probe.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define PING_WINDOW                     1024        // Requests tracked per unit (power of two)
+#define PING_EXACT_BUCKETS              32          // Round-trip times below this are counted exactly
+#define PING_SUB_BUCKETS                16          // Buckets per octave above (resolution 1/16)
+#define PING_BUCKETS                    (PING_EXACT_BUCKETS + (32 - 5) * PING_SUB_BUCKETS)
+#define PING_OCTAVES                    32          // Rows of the reported histogram (powers of two)
+#define PING_BAR_WIDTH                  40          // Characters of the longest histogram bar
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    uint16_t sequence;                      // Sequence of the request
+    uint64_t sendTime;                      // Monotonic time the request was sent (ns), 0: answered
+
+} PING_REQUEST;
+
+
+typedef struct
+{
+    struct sockaddr_in sockAddr;            // Address of the unit
+    uint16_t sequence;                      // IDN-Hello sequence of the next request
+    uint64_t dueTime;                       // Time of the next request (ns)
+    PING_REQUEST window[PING_WINDOW];       // Requests waiting for their response
+    PING_STATS stats;
+    uint64_t rttSum;                        // Sum of the round-trip times (microseconds)
+    uint32_t buckets[PING_BUCKETS];         // Round-trip times, log-linear (percentiles)
+
+} PING_TARGET;
+
+
+struct _PING_PROBE
+{
+    int fdSocket;                           // Socket of the requests and responses
+    uint8_t clientGroup;                    // Client group of the requests
+    uint64_t period;                        // Time between two requests to the same unit (ns)
+    unsigned payloadLen;                    // Payload bytes per request
+    unsigned targetCnt;                     // Number of units
+    PING_TARGET *targets;
+
+    PLT_THREAD thread;                      // Background probe (see prbStart)
+    int threadFlag;                         // Background probe running
+    uint64_t duration;                      // Run time of the background probe (ns)
+    volatile uint32_t stopFlag;             // Stop requested
+    int rc;                                 // Result of the background probe
+
+};
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+void idnLogError(const char *fmt, ...);
+void idnLogInfo(const char *fmt, ...);
+
+
+// -------------------------------------------------------------------------------------------------
+//  Tools
+// -------------------------------------------------------------------------------------------------
+
+static unsigned log2u(uint32_t value)
+{
+    unsigned exponent = 0;
+    while(value >>= 1) exponent++;
+    return exponent;
+}
+
+
+static unsigned bucketIndex(uint32_t rtt)
+{
+    // Exact below 32 us, 16 buckets per power of two above (error below 1/16)
+    if(rtt < PING_EXACT_BUCKETS) return rtt;
+
+    unsigned exponent = log2u(rtt);
+    return PING_EXACT_BUCKETS + (exponent - 5) * PING_SUB_BUCKETS + ((rtt >> (exponent - 4)) & (PING_SUB_BUCKETS - 1));
+}
+
+
+static uint32_t bucketLimit(unsigned index)
+{
+    // Highest round-trip time of the bucket
+    if(index < PING_EXACT_BUCKETS) return index;
+
+    unsigned exponent = 5 + (index - PING_EXACT_BUCKETS) / PING_SUB_BUCKETS;
+    uint64_t sub = (index - PING_EXACT_BUCKETS) % PING_SUB_BUCKETS;
+    return (uint32_t)(((PING_SUB_BUCKETS + sub + 1) << (exponent - 4)) - 1);
+}
+
+
+static uint32_t percentile(PING_TARGET *target, unsigned permille)
+{
+    // Note: The bucket limit, capped by the measured maximum
+    uint64_t rank = ((uint64_t)target->stats.recvCnt * permille + 999) / 1000;
+    uint64_t count = 0;
+    for(unsigned i = 0; i < PING_BUCKETS; i++)
+    {
+        count += target->buckets[i];
+        if(count < rank) continue;
+
+        uint32_t limit = bucketLimit(i);
+        return (limit < target->stats.rttMax) ? limit : target->stats.rttMax;
+    }
+
+    return target->stats.rttMax;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  Requests and responses
+// -------------------------------------------------------------------------------------------------
+
+static void sendRequest(PING_PROBE *prb, PING_TARGET *target, uint64_t now)
+{
+    // IDN-Hello ping, payload derived from the sequence (checked in the response)
+    uint8_t buffer[sizeof(IDNHDR_PACKET) + PING_MAX_PAYLOAD];
+    IDNHDR_PACKET *packetHdr = (IDNHDR_PACKET *)buffer;
+    uint16_t sequence = target->sequence++;
+    packetHdr->command = IDNCMD_PING_REQUEST;
+    packetHdr->flags = prb->clientGroup;
+    packetHdr->sequence = htons(sequence);
+    for(unsigned i = 0; i < prb->payloadLen; i++) buffer[sizeof(IDNHDR_PACKET) + i] = (uint8_t)(sequence + i);
+
+    unsigned length = sizeof(IDNHDR_PACKET) + prb->payloadLen;
+    if(sendto(prb->fdSocket, (const char *)buffer, length, 0, (struct sockaddr *)&target->sockAddr, sizeof(target->sockAddr)) < 0)
+    {
+        target->stats.sendErrorCnt++;
+        return;
+    }
+
+    // Note: A request unanswered for the whole window is overwritten (lost anyway)
+    PING_REQUEST *request = &target->window[sequence & (PING_WINDOW - 1)];
+    request->sequence = sequence;
+    request->sendTime = now;
+    target->stats.sentCnt++;
+}
+
+
+static void receiveResponse(PING_PROBE *prb, const uint8_t *buffer, unsigned length, struct sockaddr_in *fromAddr,
+                            uint64_t now)
+{
+    // Response of a request waiting? Note: Duplicates and unknown sequences are ignored.
+    if(length < sizeof(IDNHDR_PACKET)) return;
+    const IDNHDR_PACKET *packetHdr = (const IDNHDR_PACKET *)buffer;
+    if(packetHdr->command != IDNCMD_PING_RESPONSE) return;
+
+    PING_TARGET *target = (PING_TARGET *)0;
+    for(unsigned i = 0; i < prb->targetCnt; i++)
+    {
+        if(prb->targets[i].sockAddr.sin_addr.s_addr != fromAddr->sin_addr.s_addr) continue;
+        target = &prb->targets[i];
+        break;
+    }
+    if(!target) return;
+
+    uint16_t sequence = ntohs(packetHdr->sequence);
+    PING_REQUEST *request = &target->window[sequence & (PING_WINDOW - 1)];
+    if(!request->sendTime || (request->sequence != sequence)) return;
+    uint64_t rttNS = now - request->sendTime;
+    request->sendTime = 0;
+
+    // Payload copied?
+    int validFlag = (length == sizeof(IDNHDR_PACKET) + prb->payloadLen);
+    for(unsigned i = 0; validFlag && (i < prb->payloadLen); i++)
+    {
+        if(buffer[sizeof(IDNHDR_PACKET) + i] != (uint8_t)(sequence + i)) validFlag = 0;
+    }
+    if(!validFlag) { target->stats.invalidCnt++; return; }
+    if(rttNS > (uint64_t)PING_TIMEOUT * 1000000) { target->stats.lateCnt++; return; }
+
+    // Round-trip time
+    PING_STATS *stats = &target->stats;
+    uint32_t rtt = (uint32_t)(rttNS / 1000);
+    if(!stats->recvCnt || (rtt < stats->rttMin)) stats->rttMin = rtt;
+    if(rtt > stats->rttMax) stats->rttMax = rtt;
+    target->rttSum += rtt;
+    target->buckets[bucketIndex(rtt)]++;
+    stats->recvCnt++;
+}
+
+
+static void receiveAll(PING_PROBE *prb)
+{
+    uint8_t buffer[sizeof(IDNHDR_PACKET) + PING_MAX_PAYLOAD];
+    struct sockaddr_in fromAddr;
+    int length;
+    while((length = plt_sockRecvFromNow(prb->fdSocket, buffer, sizeof(buffer), &fromAddr)) > 0)
+    {
+        receiveResponse(prb, buffer, (unsigned)length, &fromAddr, plt_readMonoClockNS());
+    }
+}
+
+
+static int pendingRequests(PING_PROBE *prb, uint64_t now)
+{
+    // Requests still in time for a response
+    for(unsigned i = 0; i < prb->targetCnt; i++)
+    {
+        for(unsigned k = 0; k < PING_WINDOW; k++)
+        {
+            uint64_t sendTime = prb->targets[i].window[k].sendTime;
+            if(sendTime && (now - sendTime < (uint64_t)PING_TIMEOUT * 1000000)) return 1;
+        }
+    }
+
+    return 0;
+}
+
+
+static PLT_THREAD_RESULT PLT_THREAD_CALL probeThread(void *arg)
+{
+    PING_PROBE *prb = (PING_PROBE *)arg;
+    prb->rc = prbRun(prb, prb->duration);
+    return 0;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  API
+// -------------------------------------------------------------------------------------------------
+
+PING_PROBE *prbCreate(const uint32_t *serverAddrs, unsigned targetCnt, unsigned rate, unsigned payloadLen,
+                      uint8_t clientGroup)
+{
+    if(!targetCnt || (targetCnt > PING_MAX_TARGETS) || !rate || (payloadLen > PING_MAX_PAYLOAD)) return (PING_PROBE *)0;
+
+    PING_PROBE *prb = (PING_PROBE *)calloc(1, sizeof(PING_PROBE));
+    if(!prb) return (PING_PROBE *)0;
+    prb->targets = (PING_TARGET *)calloc(targetCnt, sizeof(PING_TARGET));
+    prb->fdSocket = plt_sockOpen(AF_INET, SOCK_DGRAM, 0);
+    if(!prb->targets || (prb->fdSocket < 0))
+    {
+        idnLogError("[PNG] Probe setup failed (error: %d)", plt_sockGetLastError());
+        prbDestroy(prb);
+        return (PING_PROBE *)0;
+    }
+
+    prb->clientGroup = clientGroup;
+    prb->period = 1000000000ull / rate;
+    prb->payloadLen = payloadLen;
+    prb->targetCnt = targetCnt;
+    for(unsigned i = 0; i < targetCnt; i++)
+    {
+        PING_TARGET *target = &prb->targets[i];
+        target->sockAddr.sin_family = AF_INET;
+        target->sockAddr.sin_port = htons(IDNVAL_HELLO_UDP_PORT);
+        target->sockAddr.sin_addr.s_addr = serverAddrs[i];
+        target->stats.serverAddr = serverAddrs[i];
+    }
+
+    return prb;
+}
+
+
+void prbDestroy(PING_PROBE *prb)
+{
+    prbStop(prb);
+    if(prb->fdSocket >= 0) plt_sockClose(prb->fdSocket);
+    if(prb->targets) free(prb->targets);
+    free(prb);
+}
+
+
+int prbRun(PING_PROBE *prb, uint64_t duration)
+{
+    // Note: Real time (the virtual clock does not apply to the network)
+    uint64_t now = plt_readMonoClockNS();
+    uint64_t end = duration ? now + duration : UINT64_MAX;
+    for(unsigned i = 0; i < prb->targetCnt; i++) prb->targets[i].dueTime = now + (prb->period * i) / prb->targetCnt;
+
+    while(!plt_atomicLoad32(&prb->stopFlag) && (now < end))
+    {
+        // Requests due. Note: Behind by more than a period (stalled), the schedule starts over.
+        uint64_t next = end;
+        for(unsigned i = 0; i < prb->targetCnt; i++)
+        {
+            PING_TARGET *target = &prb->targets[i];
+            if(target->dueTime <= now)
+            {
+                sendRequest(prb, target, now);
+                target->dueTime += prb->period;
+                if(target->dueTime <= now) target->dueTime = now + prb->period;
+            }
+            if(target->dueTime < next) next = target->dueTime;
+        }
+
+        // Responses until the next request is due
+        while(plt_sockWaitRecvUntilNS(prb->fdSocket, next)) receiveAll(prb);
+        now = plt_readMonoClockNS();
+    }
+
+    // Responses still in time
+    uint64_t drainEnd = plt_readMonoClockNS() + (uint64_t)PING_TIMEOUT * 1000000;
+    while(pendingRequests(prb, plt_readMonoClockNS()) && plt_sockWaitRecvUntilNS(prb->fdSocket, drainEnd)) receiveAll(prb);
+
+    return 0;
+}
+
+
+int prbStart(PING_PROBE *prb, uint64_t duration)
+{
+    prb->duration = duration;
+    plt_atomicStore32(&prb->stopFlag, 0);
+    if(plt_threadCreate(&prb->thread, probeThread, prb))
+    {
+        idnLogError("[PNG] Probe thread creation failed");
+        return -1;
+    }
+
+    prb->threadFlag = 1;
+    return 0;
+}
+
+
+void prbStop(PING_PROBE *prb)
+{
+    // Note: The thread waits for the responses still in time before it returns
+    if(!prb->threadFlag) return;
+
+    plt_atomicStore32(&prb->stopFlag, 1);
+    plt_threadJoin(prb->thread);
+    prb->threadFlag = 0;
+}
+
+
+void prbGetStats(PING_PROBE *prb, unsigned targetIndex, PING_STATS *stats)
+{
+    PING_TARGET *target = &prb->targets[targetIndex];
+    memcpy(stats, &target->stats, sizeof(PING_STATS));
+    stats->rttAvg = stats->recvCnt ? (uint32_t)(target->rttSum / stats->recvCnt) : 0;
+    stats->rttP50 = percentile(target, 500);
+    stats->rttP90 = percentile(target, 900);
+    stats->rttP99 = percentile(target, 990);
+}
+
+
+void prbReport(PING_PROBE *prb)
+{
+    // Per unit: Summary, then the round-trip times per power of two
+    for(unsigned i = 0; i < prb->targetCnt; i++)
+    {
+        PING_STATS stats;
+        prbGetStats(prb, i, &stats);
+        struct in_addr addr;
+        addr.s_addr = stats.serverAddr;
+
+        uint32_t lostCnt = stats.sentCnt - stats.recvCnt;
+        idnLogInfo("[PNG] %s: %u sent, %u received, %u lost (%.1f%%, %u late), %u invalid, %u send errors",
+                   inet_ntoa(addr), stats.sentCnt, stats.recvCnt, lostCnt,
+                   stats.sentCnt ? 100.0 * (double)lostCnt / (double)stats.sentCnt : 0.0, stats.lateCnt,
+                   stats.invalidCnt, stats.sendErrorCnt);
+        if(!stats.recvCnt) continue;
+
+        idnLogInfo("[PNG] %s: round trip min %u us, avg %u us, p50 %u us, p90 %u us, p99 %u us, max %u us",
+                   inet_ntoa(addr), stats.rttMin, stats.rttAvg, stats.rttP50, stats.rttP90, stats.rttP99, stats.rttMax);
+
+        PING_TARGET *target = &prb->targets[i];
+        uint32_t octaves[PING_OCTAVES];
+        memset(octaves, 0, sizeof(octaves));
+        for(unsigned k = 0; k < PING_BUCKETS; k++) octaves[log2u(bucketLimit(k) | 1)] += target->buckets[k];
+
+        unsigned first = log2u(stats.rttMin | 1), last = log2u(stats.rttMax | 1);
+        uint32_t peak = 0;
+        for(unsigned k = first; k <= last; k++) if(octaves[k] > peak) peak = octaves[k];
+        for(unsigned k = first; k <= last; k++)
+        {
+            char bar[PING_BAR_WIDTH + 1];
+            unsigned width = (unsigned)(((uint64_t)octaves[k] * PING_BAR_WIDTH + peak - 1) / peak);
+            memset(bar, '#', width);
+            bar[width] = '\0';
+            idnLogInfo("[PNG]   %7u - %7u us %7u %5.1f%% %s", k ? (1u << k) : 0, (2u << k) - 1, octaves[k],
+                       100.0 * (double)octaves[k] / (double)stats.recvCnt, bar);
+        }
+    }
+}
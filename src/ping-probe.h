@@ -0,0 +1,95 @@
+// -------------------------------------------------------------------------------------------------
+//  File ping-probe.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+#ifndef PING_PROBE_H
+#define PING_PROBE_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define PING_MAX_TARGETS                64          // Maximum number of units probed at a time
+#define PING_MAX_PAYLOAD                1400        // Maximum payload per request (one datagram)
+#define PING_DEFAULT_RATE               10          // Requests per second and unit
+#define PING_DEFAULT_PAYLOAD            16          // Payload bytes per request
+#define PING_TIMEOUT                    1000        // Responses later than this count as lost (ms)
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct _PING_PROBE PING_PROBE;
+
+typedef struct
+{
+    uint32_t serverAddr;                    // IPv4 address of the unit (network byte order)
+    uint32_t sentCnt;                       // Number of requests sent
+    uint32_t recvCnt;                       // Number of responses in time
+    uint32_t lateCnt;                       // Number of responses after the timeout (counted lost)
+    uint32_t invalidCnt;                    // Number of responses with a payload not matching the request
+    uint32_t sendErrorCnt;                  // Number of requests the socket refused
+    uint32_t rttMin;                        // Round-trip times (microseconds), percentiles
+    uint32_t rttAvg;                        // within the histogram resolution (1/16 octave)
+    uint32_t rttP50;
+    uint32_t rttP90;
+    uint32_t rttP99;
+    uint32_t rttMax;
+
+} PING_STATS;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+// Note: Own socket, requests to all units spread over the period (no bursts). The IDN-Hello
+// sequence of the requests matches the responses, streams to the same units are not touched.
+PING_PROBE *prbCreate(const uint32_t *serverAddrs, unsigned targetCnt, unsigned rate, unsigned payloadLen,
+                      uint8_t clientGroup);
+void prbDestroy(PING_PROBE *prb);
+
+// Probe for the given time (ns, 0: until stopped), then wait for the late responses
+int prbRun(PING_PROBE *prb, uint64_t duration);
+
+// Note: Background thread (scheduling settings of the caller), stop joins it
+int prbStart(PING_PROBE *prb, uint64_t duration);
+void prbStop(PING_PROBE *prb);
+
+void prbGetStats(PING_PROBE *prb, unsigned targetIndex, PING_STATS *stats);
+void prbReport(PING_PROBE *prb);
+
+
+#endif
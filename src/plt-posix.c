@@ -37,6 +37,6 @@
 // -------------------------------------------------------------------------------------------------
 
 int plt_monoValid = 0;
-struct timespec plt_monoRef = { 0 };
-uint32_t plt_monoTimeUS = 0;
+int plt_virtualClock = 0;
+volatile uint64_t plt_virtualTimeNS = 0;
 
@@ -33,12 +33,65 @@
 
 
 // Standard libraries
+#include <stdint.h>
+#include <string.h>
 #include <unistd.h>
 #include <errno.h>
 #include <time.h>
 
 // Platform headers
 #include <arpa/inet.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <poll.h>
+#include <stdio.h>
+
+#if defined(__linux__)
+#include <linux/net_tstamp.h>
+#include <linux/errqueue.h>
+#include <sys/inotify.h>
+#endif
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define PLT_CLOCK_REALTIME              CLOCK_REALTIME
+#define PLT_CLOCK_MONOTONIC             CLOCK_MONOTONIC
+
+#if defined(CLOCK_TAI)
+#define PLT_CLOCK_TAI                   CLOCK_TAI
+#else
+#define PLT_CLOCK_TAI                   11
+#endif
+
+#define PLT_THREAD_CALL
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef pthread_t PLT_THREAD;
+typedef pthread_mutex_t PLT_MUTEX;
+typedef pthread_cond_t PLT_COND;
+typedef void *PLT_THREAD_RESULT;
+typedef PLT_THREAD_RESULT (PLT_THREAD_CALL *PLT_THREAD_FUNC)(void *arg);
+
+typedef struct
+{
+    void *ptr;                              // Mapped memory
+    size_t size;                            // Size of the mapping
+    char name[64];                          // Name of the shared memory object
+
+} PLT_SHM;
 
 
 // -------------------------------------------------------------------------------------------------
@@ -48,16 +101,13 @@
 inline static int plt_validateMonoTime()
 {
     extern int plt_monoValid;
-    extern struct timespec plt_monoRef;
-    extern uint32_t plt_monoTimeUS;
 
     if(!plt_monoValid)
     {
-        // Initialize time reference
-        if(clock_gettime(CLOCK_MONOTONIC, &plt_monoRef) < 0) return -1;
+        // Check the monotonic clock
+        struct timespec tsNow;
+        if(clock_gettime(CLOCK_MONOTONIC, &tsNow) < 0) return -1;
 
-        // Initialize internal time randomly
-        plt_monoTimeUS = (uint32_t)((plt_monoRef.tv_sec * 1000000ul) + (plt_monoRef.tv_nsec / 1000));
         plt_monoValid = 1;
     }
 
@@ -65,38 +115,112 @@ inline static int plt_validateMonoTime()
 }
 
 
-inline static uint32_t plt_getMonoTimeUS()
+// Monotonic clock reading in nanoseconds (64 bit, no wrap-around), ignores the virtual clock
+inline static uint64_t plt_readMonoClockNS()
 {
-    extern struct timespec plt_monoRef;
-    extern uint32_t plt_monoTimeUS;
-
-    // Get current time
-    struct timespec tsNow, tsDiff;
+    struct timespec tsNow;
     clock_gettime(CLOCK_MONOTONIC, &tsNow);
 
-    // Determine difference to reference time
-    if(tsNow.tv_nsec < plt_monoRef.tv_nsec) 
+    return ((uint64_t)tsNow.tv_sec * 1000000000ull) + (uint64_t)tsNow.tv_nsec;
+}
+
+
+// Virtual clock: Time only advances by sleeping, sleeping returns instantly
+inline static void plt_enableVirtualClock()
+{
+    extern int plt_virtualClock;
+    extern volatile uint64_t plt_virtualTimeNS;
+
+    // Start at the current time, so that timestamps look like the ones of a real-time run
+    __atomic_store_n(&plt_virtualTimeNS, plt_readMonoClockNS(), __ATOMIC_SEQ_CST);
+    plt_virtualClock = 1;
+}
+
+
+inline static int plt_isVirtualClock()
+{
+    extern int plt_virtualClock;
+
+    return plt_virtualClock;
+}
+
+
+inline static void plt_advanceVirtualClock(uint64_t nsDeadline)
+{
+    extern volatile uint64_t plt_virtualTimeNS;
+
+    // Note: Never moves back (several sleeping threads)
+    uint64_t nsNow = __atomic_load_n(&plt_virtualTimeNS, __ATOMIC_SEQ_CST);
+    while((nsDeadline > nsNow) &&
+          !__atomic_compare_exchange_n(&plt_virtualTimeNS, &nsNow, nsDeadline, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST)) { }
+}
+
+
+// Monotonic time in nanoseconds (64 bit, no wrap-around), safe for any thread. Virtual time if enabled.
+inline static uint64_t plt_getMonoTimeNS()
+{
+    extern int plt_virtualClock;
+    extern volatile uint64_t plt_virtualTimeNS;
+
+    if(plt_virtualClock) return __atomic_load_n(&plt_virtualTimeNS, __ATOMIC_SEQ_CST);
+
+    return plt_readMonoClockNS();
+}
+
+
+// CPU time consumed by the process (all threads) in nanoseconds
+inline static uint64_t plt_readCPUTimeNS()
+{
+    struct timespec tsNow;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &tsNow);
+
+    return ((uint64_t)tsNow.tv_sec * 1000000000ull) + (uint64_t)tsNow.tv_nsec;
+}
+
+
+inline static int plt_usleep(unsigned usec)
+{
+    extern int plt_virtualClock;
+
+    if(plt_virtualClock)
     {
-        tsDiff.tv_sec = (tsNow.tv_sec - plt_monoRef.tv_sec) - 1;
-        tsDiff.tv_nsec = (1000000000 + tsNow.tv_nsec) - plt_monoRef.tv_nsec;
-    } 
-    else 
+        plt_advanceVirtualClock(plt_getMonoTimeNS() + (uint64_t)usec * 1000);
+        return 0;
+    }
+
+    return usleep(usec);
+}
+
+
+inline static int plt_sleepUntilNS(uint64_t nsDeadline)
+{
+    extern int plt_virtualClock;
+
+    if(plt_virtualClock)
     {
-        tsDiff.tv_sec = tsNow.tv_sec - plt_monoRef.tv_sec;
-        tsDiff.tv_nsec = tsNow.tv_nsec - plt_monoRef.tv_nsec;
+        plt_advanceVirtualClock(nsDeadline);
+        return 0;
     }
 
-    // Update internal time and system time reference
-    plt_monoTimeUS += (uint32_t)((tsDiff.tv_sec * 1000000) + (tsDiff.tv_nsec / 1000));
-    plt_monoRef = tsNow;
+    struct timespec tsWake;
+    tsWake.tv_sec = (time_t)(nsDeadline / 1000000000ull);
+    tsWake.tv_nsec = (long)(nsDeadline % 1000000000ull);
 
-    return plt_monoTimeUS;
+    // Absolute wake-up time, so an interrupted or late wake-up does not add up
+    int rc;
+    while((rc = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &tsWake, NULL)) == EINTR) { }
+
+    return rc;
 }
 
 
-inline static int plt_usleep(unsigned usec)
+inline static void plt_waitUntilNS(uint64_t nsDeadline, uint64_t nsSpin)
 {
-    return usleep(usec);
+    // Sleep, then busy-wait the last part (scheduler wake-up latency). Note: Virtual time only
+    // advances by sleeping, nothing to spin for.
+    if(plt_isVirtualClock()) { plt_sleepUntilNS(nsDeadline); return; }
+    if(nsDeadline > nsSpin) plt_sleepUntilNS(nsDeadline - nsSpin);
+    while(plt_getMonoTimeNS() < nsDeadline) { }
 }
 
 
@@ -136,5 +260,519 @@ inline static int plt_sockClose(int fdSocket)
 }
 
 
+// Listen on a local (Unix domain) stream socket, non-blocking. A stale socket file is replaced.
+inline static int plt_localListen(const char *path)
+{
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if(strlen(path) >= sizeof(addr.sun_path)) { errno = ENAMETOOLONG; return -1; }
+    strcpy(addr.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(fd < 0) return -1;
+
+    unlink(path);
+    if((bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) || (listen(fd, 4) < 0) ||
+       (fcntl(fd, F_SETFL, O_NONBLOCK) < 0))
+    {
+        int rc = errno;
+        close(fd);
+        errno = rc;
+        return -1;
+    }
+
+    return fd;
+}
+
+
+inline static void plt_localClose(int fd, const char *path)
+{
+    close(fd);
+    unlink(path);
+}
+
+
+// Accept a connection (non-blocking), -1 if none pending
+inline static int plt_sockAccept(int fdListen)
+{
+    int fd = accept(fdListen, (struct sockaddr *)0, (socklen_t *)0);
+    if((fd >= 0) && (fcntl(fd, F_SETFL, O_NONBLOCK) < 0)) { close(fd); return -1; }
+
+    return fd;
+}
+
+
+// Send on a connected socket. Note: A closed peer is an error, not a signal.
+inline static int plt_sockSend(int fdSocket, const void *buffer, unsigned length)
+{
+    return (int)send(fdSocket, buffer, length, MSG_NOSIGNAL);
+}
+
+
+// Receive a datagram if one is waiting (never blocks), 0 if none
+inline static int plt_sockRecvFromNow(int fdSocket, void *buffer, unsigned length, struct sockaddr_in *fromAddr)
+{
+    socklen_t addrLen = sizeof(struct sockaddr_in);
+    ssize_t rc = recvfrom(fdSocket, buffer, length, MSG_DONTWAIT, (struct sockaddr *)fromAddr, &addrLen);
+    if(rc < 0) return ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ECONNREFUSED)) ? 0 : -1;
+
+    return (int)rc;
+}
+
+
+// Wait until a datagram (or an error) is waiting or the deadline (monotonic time) passed, nonzero: readable
+inline static int plt_sockWaitRecvUntilNS(int fdSocket, uint64_t nsDeadline)
+{
+    uint64_t now = plt_readMonoClockNS();
+    if(now >= nsDeadline) return 0;
+
+    struct pollfd pfd;
+    pfd.fd = fdSocket;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+#if defined(__linux__)
+    struct timespec tsTimeout;
+    tsTimeout.tv_sec = (time_t)((nsDeadline - now) / 1000000000ull);
+    tsTimeout.tv_nsec = (long)((nsDeadline - now) % 1000000000ull);
+
+    return (ppoll(&pfd, 1, &tsTimeout, (const sigset_t *)0) > 0) && (pfd.revents & (POLLIN | POLLERR));
+#else
+    // Note: Milliseconds rounded down (never past the deadline)
+    return (poll(&pfd, 1, (int)((nsDeadline - now) / 1000000)) > 0) && (pfd.revents & (POLLIN | POLLERR));
+#endif
+}
+
+
+// Watch for files completely written (closed) or moved into place, non-blocking. -1 if not supported.
+inline static int plt_fileWatchOpen(void)
+{
+#if defined(__linux__)
+    return inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+
+// Watch the directory of the passed file (editors and exporters often replace the file)
+inline static int plt_fileWatchAdd(int fdWatch, const char *path)
+{
+#if defined(__linux__)
+    char dir[1024];
+    const char *sep = strrchr(path, '/');
+    if(!sep) strcpy(dir, ".");
+    else if(sep == path) strcpy(dir, "/");
+    else if((size_t)(sep - path) < sizeof(dir)) { memcpy(dir, path, sep - path); dir[sep - path] = 0; }
+    else { errno = ENAMETOOLONG; return -1; }
+
+    return (inotify_add_watch(fdWatch, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) ? -1 : 0;
+#else
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+
+// Drain the pending events, number of files changed (the caller checks its files, see plt_getFileStamp)
+inline static int plt_fileWatchRead(int fdWatch)
+{
+    int eventCnt = 0;
+#if defined(__linux__)
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+    ssize_t len;
+    while((len = read(fdWatch, buffer, sizeof(buffer))) > 0)
+    {
+        for(char *p = buffer; p < buffer + len; p += sizeof(struct inotify_event) + ((struct inotify_event *)p)->len)
+        {
+            eventCnt++;
+        }
+    }
+#endif
+
+    return eventCnt;
+}
+
+
+inline static void plt_fileWatchClose(int fdWatch)
+{
+    close(fdWatch);
+}
+
+
+// Modification time and size of a file (identify a version of the file)
+inline static int plt_getFileStamp(const char *path, uint64_t *mtimeNS, uint64_t *size)
+{
+    struct stat st;
+    if(stat(path, &st) < 0) return -1;
+
+#if defined(__APPLE__)
+    *mtimeNS = ((uint64_t)st.st_mtimespec.tv_sec * 1000000000ull) + (uint64_t)st.st_mtimespec.tv_nsec;
+#else
+    *mtimeNS = ((uint64_t)st.st_mtim.tv_sec * 1000000000ull) + (uint64_t)st.st_mtim.tv_nsec;
+#endif
+    *size = (uint64_t)st.st_size;
+
+    return 0;
+}
+
+
+inline static int64_t plt_getClockNS(int clockID)
+{
+    struct timespec tsNow;
+    if(clock_gettime((clockid_t)clockID, &tsNow) < 0) return 0;
+
+    return ((int64_t)tsNow.tv_sec * 1000000000ll) + (int64_t)tsNow.tv_nsec;
+}
+
+
+inline static int plt_sockEnableTxTime(int fdSocket, int clockID)
+{
+#if defined(__linux__) && defined(SO_TXTIME)
+    // Launch time per datagram, report packets dropped by the qdisc (invalid or missed launch time)
+    struct sock_txtime txtCfg;
+    txtCfg.clockid = (clockid_t)clockID;
+    txtCfg.flags = SOF_TXTIME_REPORT_ERRORS;
+    if(setsockopt(fdSocket, SOL_SOCKET, SO_TXTIME, &txtCfg, sizeof(txtCfg)) < 0) return -1;
+
+    // Software transmit timestamps (taken by the driver, after the qdisc) to verify the launch times
+    int tsFlags = SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE |
+                  SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY;
+    if(setsockopt(fdSocket, SOL_SOCKET, SO_TIMESTAMPING, &tsFlags, sizeof(tsFlags)) < 0) return -1;
+
+    return 0;
+#else
+    errno = ENOPROTOOPT;
+    return -1;
+#endif
+}
+
+
+inline static int plt_sockDisableTxTimestamps(int fdSocket)
+{
+#if defined(__linux__) && defined(SO_TXTIME)
+    int tsFlags = 0;
+    return setsockopt(fdSocket, SOL_SOCKET, SO_TIMESTAMPING, &tsFlags, sizeof(tsFlags));
+#else
+    return 0;
+#endif
+}
+
+
+inline static int plt_sockSendToAt(int fdSocket, const void *buffer, unsigned length,
+                                   const struct sockaddr *destAddr, socklen_t addrLen, int64_t launchTimeNS)
+{
+#if defined(__linux__) && defined(SO_TXTIME)
+    struct iovec iov;
+    iov.iov_base = (void *)buffer;
+    iov.iov_len = length;
+
+    // Control message buffer, properly aligned for the cmsg macros
+    union { char buf[CMSG_SPACE(sizeof(uint64_t))]; struct cmsghdr align; } control;
+    memset(&control, 0, sizeof(control));
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_name = (void *)destAddr;
+    msg.msg_namelen = addrLen;
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+
+    // Attach the launch time (in the clock passed with SO_TXTIME)
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_TXTIME;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint64_t));
+    uint64_t txTime = (uint64_t)launchTimeNS;
+    memcpy(CMSG_DATA(cmsg), &txTime, sizeof(txTime));
+
+    return (int)sendmsg(fdSocket, &msg, 0);
+#else
+    errno = ENOPROTOOPT;
+    return -1;
+#endif
+}
+
+
+// Read one entry from the socket error queue (non-blocking). Returns 1 for a transmit timestamp
+// (CLOCK_REALTIME), 2 for a packet dropped because of its launch time, 3 for any other entry
+// and 0 when the queue is empty.
+inline static int plt_sockReadTxReport(int fdSocket, uint32_t *datagramID, int64_t *timestampNS)
+{
+#if defined(__linux__) && defined(SO_TXTIME)
+    char data[64], control[256];
+    struct iovec iov;
+    iov.iov_base = data;
+    iov.iov_len = sizeof(data);
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    if(recvmsg(fdSocket, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+    {
+        return ((errno == EAGAIN) || (errno == EWOULDBLOCK)) ? 0 : -1;
+    }
+
+    int64_t tsValue = 0;
+    int rc = 3;
+    for(struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SO_TIMESTAMPING))
+        {
+            struct timespec ts[3];
+            memcpy(ts, CMSG_DATA(cmsg), sizeof(ts));
+            tsValue = ((int64_t)ts[0].tv_sec * 1000000000ll) + (int64_t)ts[0].tv_nsec;
+        }
+        else if((cmsg->cmsg_level == SOL_IP) && (cmsg->cmsg_type == IP_RECVERR))
+        {
+            struct sock_extended_err ee;
+            memcpy(&ee, CMSG_DATA(cmsg), sizeof(ee));
+            if(ee.ee_origin == SO_EE_ORIGIN_TXTIME) rc = 2;
+            else if(ee.ee_origin == SO_EE_ORIGIN_TIMESTAMPING) rc = 1;
+            *datagramID = ee.ee_data;
+        }
+    }
+
+    *timestampNS = tsValue;
+    return rc;
+#else
+    return 0;
+#endif
+}
+
+
+inline static int plt_threadCreate(PLT_THREAD *thread, PLT_THREAD_FUNC func, void *arg)
+{
+    return pthread_create(thread, NULL, func, arg);
+}
+
+
+inline static int plt_threadJoin(PLT_THREAD thread)
+{
+    return pthread_join(thread, NULL);
+}
+
+
+inline static void plt_threadYield()
+{
+    sched_yield();
+}
+
+
+inline static void plt_mutexInit(PLT_MUTEX *mutex)
+{
+    pthread_mutex_init(mutex, NULL);
+}
+
+
+inline static void plt_mutexDestroy(PLT_MUTEX *mutex)
+{
+    pthread_mutex_destroy(mutex);
+}
+
+
+inline static void plt_mutexLock(PLT_MUTEX *mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+
+inline static void plt_mutexUnlock(PLT_MUTEX *mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+
+inline static void plt_condInit(PLT_COND *cond)
+{
+    // Note: Timed waits use the monotonic clock
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(cond, &attr);
+    pthread_condattr_destroy(&attr);
+}
+
+
+inline static void plt_condDestroy(PLT_COND *cond)
+{
+    pthread_cond_destroy(cond);
+}
+
+
+inline static void plt_condWait(PLT_COND *cond, PLT_MUTEX *mutex)
+{
+    pthread_cond_wait(cond, mutex);
+}
+
+
+// Returns 0 when signaled (or spuriously woken up), nonzero at the deadline. Note: Without
+// timeout on the virtual clock (time does not pass while waiting).
+inline static int plt_condWaitUntilNS(PLT_COND *cond, PLT_MUTEX *mutex, uint64_t nsDeadline)
+{
+    extern int plt_virtualClock;
+
+    if(plt_virtualClock)
+    {
+        pthread_cond_wait(cond, mutex);
+        return 0;
+    }
+
+    struct timespec tsWake;
+    tsWake.tv_sec = (time_t)(nsDeadline / 1000000000ull);
+    tsWake.tv_nsec = (long)(nsDeadline % 1000000000ull);
+
+    return (pthread_cond_timedwait(cond, mutex, &tsWake) == ETIMEDOUT) ? 1 : 0;
+}
+
+
+inline static void plt_condSignal(PLT_COND *cond)
+{
+    pthread_cond_signal(cond);
+}
+
+
+inline static void plt_condBroadcast(PLT_COND *cond)
+{
+    pthread_cond_broadcast(cond);
+}
+
+
+// Number of CPU cores available
+inline static unsigned plt_getCPUCount()
+{
+    long cnt = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cnt > 0) ? (unsigned)cnt : 1;
+}
+
+
+// CPU time consumed by the calling thread in nanoseconds
+inline static uint64_t plt_readThreadCPUTimeNS()
+{
+    struct timespec tsNow;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &tsNow);
+
+    return ((uint64_t)tsNow.tv_sec * 1000000000ull) + (uint64_t)tsNow.tv_nsec;
+}
+
+
+// Pin the calling thread to a CPU core
+inline static int plt_threadSetAffinity(int cpu)
+{
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(cpu, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+#else
+    return ENOTSUP;
+#endif
+}
+
+
+// Real-time FIFO scheduling for the calling thread (needs CAP_SYS_NICE or an rtprio limit)
+inline static int plt_threadSetRealtime(int priority)
+{
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+}
+
+
+// Lock all current and future pages in memory (no page faults later on)
+inline static int plt_lockMemory()
+{
+    return (mlockall(MCL_CURRENT | MCL_FUTURE) < 0) ? errno : 0;
+}
+
+
+// Sequentially consistent 32 bit load/store (shared between threads without a lock)
+inline static uint32_t plt_atomicLoad32(volatile uint32_t *ptr)
+{
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+}
+
+
+inline static void plt_atomicStore32(volatile uint32_t *ptr, uint32_t value)
+{
+    __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+
+inline static uint32_t plt_atomicExchange32(volatile uint32_t *ptr, uint32_t value)
+{
+    return __atomic_exchange_n(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+
+inline static uint32_t plt_atomicAdd32(volatile uint32_t *ptr, uint32_t value)
+{
+    return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+
+// Store the value if the current value is the expected one, nonzero on success
+inline static int plt_atomicCompareExchange32(volatile uint32_t *ptr, uint32_t expected, uint32_t value)
+{
+    return __atomic_compare_exchange_n(ptr, &expected, value, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST) ? 1 : 0;
+}
+
+
+// Named shared memory (between processes), zero-filled when created. Returns 0 on success.
+inline static int plt_shmOpen(PLT_SHM *shm, const char *name, size_t size)
+{
+    snprintf(shm->name, sizeof(shm->name), "/idtfPlayer-%s", name);
+    int fd = shm_open(shm->name, O_RDWR | O_CREAT, 0600);
+    if(fd < 0) return errno;
+
+    // Note: Extends a new object only, existing contents are kept
+    struct stat st;
+    if((fstat(fd, &st) < 0) || (((size_t)st.st_size < size) && (ftruncate(fd, size) < 0)))
+    {
+        int rc = errno;
+        close(fd);
+        return rc;
+    }
+
+    shm->ptr = mmap((void *)0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(shm->ptr == MAP_FAILED) { shm->ptr = (void *)0; return errno; }
+
+    shm->size = size;
+    return 0;
+}
+
+
+inline static void plt_shmClose(PLT_SHM *shm, int removeFlag)
+{
+    if(shm->ptr) munmap(shm->ptr, shm->size);
+    if(removeFlag) shm_unlink(shm->name);
+    shm->ptr = (void *)0;
+}
+
+
+inline static uint32_t plt_getProcessID()
+{
+    return (uint32_t)getpid();
+}
+
+
+// Process still running? Note: A process of another user counts as running.
+inline static int plt_isProcessAlive(uint32_t pid)
+{
+    return (kill((pid_t)pid, 0) == 0) || (errno == EPERM);
+}
+
+
 #endif
 
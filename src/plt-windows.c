@@ -40,6 +40,6 @@
 
 int plt_monoValid = 0;
 LARGE_INTEGER plt_monoCtrFreq;
-LARGE_INTEGER plt_monoCtrRef;
-uint32_t plt_monoTimeUS = 0;
+int plt_virtualClock = 0;
+volatile uint64_t plt_virtualTimeNS = 0;
 
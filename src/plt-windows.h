@@ -39,12 +39,37 @@
 #include <windows.h>
 
 
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define PLT_CLOCK_REALTIME              0
+#define PLT_CLOCK_MONOTONIC             1
+#define PLT_CLOCK_TAI                   11
+
+#define PLT_THREAD_CALL                 WINAPI
+
+
 // -------------------------------------------------------------------------------------------------
 //  Typedefs
 // -------------------------------------------------------------------------------------------------
 
 typedef unsigned long in_addr_t;
 
+typedef HANDLE PLT_THREAD;
+typedef CRITICAL_SECTION PLT_MUTEX;
+typedef CONDITION_VARIABLE PLT_COND;
+typedef DWORD PLT_THREAD_RESULT;
+typedef PLT_THREAD_RESULT (PLT_THREAD_CALL *PLT_THREAD_FUNC)(void *arg);
+
+typedef struct
+{
+    void *ptr;                              // Mapped memory
+    size_t size;                            // Size of the mapping
+    HANDLE handle;                          // File mapping object
+
+} PLT_SHM;
+
 
 // -------------------------------------------------------------------------------------------------
 //  Inline functions
@@ -54,55 +79,109 @@ inline static int plt_validateMonoTime()
 {
     extern int plt_monoValid;
     extern LARGE_INTEGER plt_monoCtrFreq;
-    extern LARGE_INTEGER plt_monoCtrRef;
-    extern uint32_t plt_monoTimeUS;
 
-    extern void logError(const char *fmt, ...);
+    extern void idnLogError(const char *fmt, ...);
 
     if(!plt_monoValid)
     {
-        // Get performance counter frequency
+        // Get performance counter frequency (constant after boot)
         if(QueryPerformanceFrequency(&plt_monoCtrFreq) == 0)
         {
-            logError("QueryPerformanceFrequency() error = %d", (int)GetLastError());
-            return -1;
-        }
-
-        // Initialize performance counter reference
-        if(QueryPerformanceCounter(&plt_monoCtrRef) == 0)
-        {
-            logError("QueryPerformanceCounter() error = %d", (int)GetLastError());
+            idnLogError("QueryPerformanceFrequency() error = %d", (int)GetLastError());
             return -1;
         }
 
-        // Initialize internal time randomly
-        plt_monoTimeUS = (uint32_t)((plt_monoCtrRef.QuadPart * 1000000) / plt_monoCtrFreq.QuadPart);
+        plt_monoValid = 1;
     }
 
     return 0;
 }
 
 
-inline static uint32_t plt_getMonoTimeUS(void)
+// Monotonic clock reading in nanoseconds (64 bit, no wrap-around), ignores the virtual clock
+inline static uint64_t plt_readMonoClockNS(void)
 {
     extern LARGE_INTEGER plt_monoCtrFreq;
-    extern LARGE_INTEGER plt_monoCtrRef;
-    extern uint32_t plt_monoTimeUS;
 
-    // Get current time
     LARGE_INTEGER pctNow;
     QueryPerformanceCounter(&pctNow);
 
-    // Update internal time and system time reference
-    plt_monoTimeUS += (uint32_t)(((pctNow.QuadPart - plt_monoCtrRef.QuadPart) * 1000000) / plt_monoCtrFreq.QuadPart);
-    plt_monoCtrRef = pctNow;
+    // Split to avoid overflow of the multiplication
+    uint64_t sec = (uint64_t)(pctNow.QuadPart / plt_monoCtrFreq.QuadPart);
+    uint64_t rem = (uint64_t)(pctNow.QuadPart % plt_monoCtrFreq.QuadPart);
+    return (sec * 1000000000ull) + ((rem * 1000000000ull) / (uint64_t)plt_monoCtrFreq.QuadPart);
+}
+
+
+// Virtual clock: Time only advances by sleeping, sleeping returns instantly
+inline static void plt_enableVirtualClock(void)
+{
+    extern int plt_virtualClock;
+    extern volatile uint64_t plt_virtualTimeNS;
+
+    // Start at the current time, so that timestamps look like the ones of a real-time run
+    InterlockedExchange64((volatile LONG64 *)&plt_virtualTimeNS, (LONG64)plt_readMonoClockNS());
+    plt_virtualClock = 1;
+}
+
+
+inline static int plt_isVirtualClock(void)
+{
+    extern int plt_virtualClock;
+
+    return plt_virtualClock;
+}
+
+
+inline static void plt_advanceVirtualClock(uint64_t nsDeadline)
+{
+    extern volatile uint64_t plt_virtualTimeNS;
+
+    // Note: Never moves back (several sleeping threads)
+    while(1)
+    {
+        LONG64 nsNow = InterlockedCompareExchange64((volatile LONG64 *)&plt_virtualTimeNS, 0, 0);
+        if(nsDeadline <= (uint64_t)nsNow) break;
+        if(InterlockedCompareExchange64((volatile LONG64 *)&plt_virtualTimeNS, (LONG64)nsDeadline, nsNow) == nsNow) break;
+    }
+}
+
+
+// Monotonic time in nanoseconds (64 bit, no wrap-around), safe for any thread. Virtual time if enabled.
+inline static uint64_t plt_getMonoTimeNS(void)
+{
+    extern int plt_virtualClock;
+    extern volatile uint64_t plt_virtualTimeNS;
+
+    if(plt_virtualClock) return (uint64_t)InterlockedCompareExchange64((volatile LONG64 *)&plt_virtualTimeNS, 0, 0);
 
-    return plt_monoTimeUS;
+    return plt_readMonoClockNS();
+}
+
+
+// CPU time consumed by the process (all threads) in nanoseconds
+inline static uint64_t plt_readCPUTimeNS(void)
+{
+    FILETIME ftCreation, ftExit, ftKernel, ftUser;
+    if(!GetProcessTimes(GetCurrentProcess(), &ftCreation, &ftExit, &ftKernel, &ftUser)) return 0;
+
+    // Note: 100 nanosecond units
+    uint64_t kernel = ((uint64_t)ftKernel.dwHighDateTime << 32) | ftKernel.dwLowDateTime;
+    uint64_t user = ((uint64_t)ftUser.dwHighDateTime << 32) | ftUser.dwLowDateTime;
+    return (kernel + user) * 100;
 }
 
 
 inline static int plt_usleep(unsigned usec)
 {
+    extern int plt_virtualClock;
+
+    if(plt_virtualClock)
+    {
+        plt_advanceVirtualClock(plt_getMonoTimeNS() + (uint64_t)usec * 1000);
+        return 0;
+    }
+
     HANDLE timer;
     LARGE_INTEGER ft;
 
@@ -117,6 +196,43 @@ inline static int plt_usleep(unsigned usec)
 }
 
 
+inline static int plt_sleepUntilNS(uint64_t nsDeadline)
+{
+    extern int plt_virtualClock;
+
+    if(plt_virtualClock)
+    {
+        plt_advanceVirtualClock(nsDeadline);
+        return 0;
+    }
+
+    uint64_t now = plt_getMonoTimeNS();
+    if(nsDeadline <= now) return 0;
+
+    HANDLE timer;
+    LARGE_INTEGER ft;
+
+    // Convert to 100 nanosecond interval, negative value indicates relative time
+    ft.QuadPart = -(__int64)((nsDeadline - now) / 100);
+    timer = CreateWaitableTimer(NULL, TRUE, NULL);
+    SetWaitableTimer(timer, &ft, 0, NULL, NULL, 0);
+    WaitForSingleObject(timer, INFINITE);
+    CloseHandle(timer);
+
+    return 0;
+}
+
+
+inline static void plt_waitUntilNS(uint64_t nsDeadline, uint64_t nsSpin)
+{
+    // Sleep, then busy-wait the last part (scheduler wake-up latency). Note: Virtual time only
+    // advances by sleeping, nothing to spin for.
+    if(plt_isVirtualClock()) { plt_sleepUntilNS(nsDeadline); return; }
+    if(nsDeadline > nsSpin) plt_sleepUntilNS(nsDeadline - nsSpin);
+    while(plt_getMonoTimeNS() < nsDeadline) { }
+}
+
+
 inline static FILE *plt_fopen(const char *filename, const char *mode)
 {
     FILE *fp;
@@ -158,5 +274,367 @@ inline static int plt_sockClose(int fdSocket)
 }
 
 
+// Note: No local control socket (the event loop cannot watch sockets on this platform)
+inline static int plt_localListen(const char *path)
+{
+    return -1;
+}
+
+
+inline static void plt_localClose(int fd, const char *path)
+{
+    closesocket(fd);
+}
+
+
+inline static int plt_sockAccept(int fdListen)
+{
+    return (int)accept(fdListen, NULL, NULL);
+}
+
+
+inline static int plt_sockSend(int fdSocket, const void *buffer, unsigned length)
+{
+    return send(fdSocket, (const char *)buffer, (int)length, 0);
+}
+
+
+inline static int plt_sockRecvFromNow(int fdSocket, void *buffer, unsigned length, struct sockaddr_in *fromAddr)
+{
+    // Note: The socket stays blocking (sends), check for a waiting datagram first
+    fd_set readSet;
+    struct timeval tvZero = { 0, 0 };
+    FD_ZERO(&readSet);
+    FD_SET((SOCKET)fdSocket, &readSet);
+    if(select(0, &readSet, NULL, NULL, &tvZero) <= 0) return 0;
+
+    int addrLen = sizeof(struct sockaddr_in);
+    int rc = recvfrom(fdSocket, (char *)buffer, (int)length, 0, (struct sockaddr *)fromAddr, &addrLen);
+    if(rc < 0) return (WSAGetLastError() == WSAECONNRESET) ? 0 : -1;
+
+    return rc;
+}
+
+
+inline static int plt_sockWaitRecvUntilNS(int fdSocket, uint64_t nsDeadline)
+{
+    uint64_t now = plt_readMonoClockNS();
+    if(now >= nsDeadline) return 0;
+
+    fd_set readSet;
+    struct timeval tvTimeout;
+    tvTimeout.tv_sec = (long)((nsDeadline - now) / 1000000000ull);
+    tvTimeout.tv_usec = (long)(((nsDeadline - now) % 1000000000ull) / 1000);
+    FD_ZERO(&readSet);
+    FD_SET((SOCKET)fdSocket, &readSet);
+
+    return select(0, &readSet, NULL, NULL, &tvTimeout) > 0;
+}
+
+
+inline static int plt_fileWatchOpen(void)
+{
+    return -1;
+}
+
+
+inline static int plt_fileWatchAdd(int fdWatch, const char *path)
+{
+    return -1;
+}
+
+
+inline static int plt_fileWatchRead(int fdWatch)
+{
+    return 0;
+}
+
+
+inline static void plt_fileWatchClose(int fdWatch)
+{
+}
+
+
+inline static int plt_getFileStamp(const char *path, uint64_t *mtimeNS, uint64_t *size)
+{
+    WIN32_FILE_ATTRIBUTE_DATA fad;
+    if(!GetFileAttributesExA(path, GetFileExInfoStandard, &fad)) return -1;
+
+    *mtimeNS = (((uint64_t)fad.ftLastWriteTime.dwHighDateTime << 32) | (uint64_t)fad.ftLastWriteTime.dwLowDateTime) * 100;
+    *size = ((uint64_t)fad.nFileSizeHigh << 32) | (uint64_t)fad.nFileSizeLow;
+
+    return 0;
+}
+
+
+inline static int64_t plt_getClockNS(int clockID)
+{
+    if(clockID == PLT_CLOCK_REALTIME)
+    {
+        // 100 nanosecond intervals since 1601-01-01, converted to the unix epoch
+        FILETIME ft;
+        GetSystemTimePreciseAsFileTime(&ft);
+        int64_t t = ((int64_t)ft.dwHighDateTime << 32) | (int64_t)ft.dwLowDateTime;
+        return (t - 116444736000000000ll) * 100;
+    }
+    else if(clockID == PLT_CLOCK_MONOTONIC)
+    {
+        return (int64_t)plt_getMonoTimeNS();
+    }
+
+    return 0;
+}
+
+
+inline static int plt_sockEnableTxTime(int fdSocket, int clockID)
+{
+    // Launch time offload is not available with Winsock
+    WSASetLastError(WSAEOPNOTSUPP);
+    return -1;
+}
+
+
+inline static int plt_sockDisableTxTimestamps(int fdSocket)
+{
+    return 0;
+}
+
+
+inline static int plt_sockSendToAt(int fdSocket, const void *buffer, unsigned length,
+                                   const struct sockaddr *destAddr, int addrLen, int64_t launchTimeNS)
+{
+    WSASetLastError(WSAEOPNOTSUPP);
+    return -1;
+}
+
+
+inline static int plt_sockReadTxReport(int fdSocket, uint32_t *datagramID, int64_t *timestampNS)
+{
+    return 0;
+}
+
+
+inline static int plt_threadCreate(PLT_THREAD *thread, PLT_THREAD_FUNC func, void *arg)
+{
+    *thread = CreateThread(NULL, 0, (LPTHREAD_START_ROUTINE)func, arg, 0, NULL);
+    return (*thread == NULL) ? -1 : 0;
+}
+
+
+inline static int plt_threadJoin(PLT_THREAD thread)
+{
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+    return 0;
+}
+
+
+inline static void plt_threadYield(void)
+{
+    SwitchToThread();
+}
+
+
+inline static void plt_mutexInit(PLT_MUTEX *mutex)
+{
+    InitializeCriticalSection(mutex);
+}
+
+
+inline static void plt_mutexDestroy(PLT_MUTEX *mutex)
+{
+    DeleteCriticalSection(mutex);
+}
+
+
+inline static void plt_mutexLock(PLT_MUTEX *mutex)
+{
+    EnterCriticalSection(mutex);
+}
+
+
+inline static void plt_mutexUnlock(PLT_MUTEX *mutex)
+{
+    LeaveCriticalSection(mutex);
+}
+
+
+inline static void plt_condInit(PLT_COND *cond)
+{
+    InitializeConditionVariable(cond);
+}
+
+
+inline static void plt_condDestroy(PLT_COND *cond)
+{
+}
+
+
+inline static void plt_condWait(PLT_COND *cond, PLT_MUTEX *mutex)
+{
+    SleepConditionVariableCS(cond, mutex, INFINITE);
+}
+
+
+// Returns 0 when signaled (or spuriously woken up), nonzero at the deadline. Note: Without
+// timeout on the virtual clock (time does not pass while waiting).
+inline static int plt_condWaitUntilNS(PLT_COND *cond, PLT_MUTEX *mutex, uint64_t nsDeadline)
+{
+    extern int plt_virtualClock;
+
+    if(plt_virtualClock)
+    {
+        SleepConditionVariableCS(cond, mutex, INFINITE);
+        return 0;
+    }
+
+    uint64_t now = plt_getMonoTimeNS();
+    if(nsDeadline <= now) return 1;
+
+    // Round up to full milliseconds (do not wake up ahead of the deadline)
+    DWORD msWait = (DWORD)(((nsDeadline - now) + 999999) / 1000000);
+    if(SleepConditionVariableCS(cond, mutex, msWait)) return 0;
+
+    return (GetLastError() == ERROR_TIMEOUT) ? 1 : 0;
+}
+
+
+inline static void plt_condSignal(PLT_COND *cond)
+{
+    WakeConditionVariable(cond);
+}
+
+
+inline static void plt_condBroadcast(PLT_COND *cond)
+{
+    WakeAllConditionVariable(cond);
+}
+
+
+// Number of CPU cores available
+inline static unsigned plt_getCPUCount(void)
+{
+    SYSTEM_INFO sysInfo;
+    GetSystemInfo(&sysInfo);
+    return sysInfo.dwNumberOfProcessors ? (unsigned)sysInfo.dwNumberOfProcessors : 1;
+}
+
+
+// CPU time consumed by the calling thread in nanoseconds
+inline static uint64_t plt_readThreadCPUTimeNS(void)
+{
+    FILETIME ftCreation, ftExit, ftKernel, ftUser;
+    if(!GetThreadTimes(GetCurrentThread(), &ftCreation, &ftExit, &ftKernel, &ftUser)) return 0;
+
+    // Note: 100 nanosecond units
+    uint64_t kernel = ((uint64_t)ftKernel.dwHighDateTime << 32) | ftKernel.dwLowDateTime;
+    uint64_t user = ((uint64_t)ftUser.dwHighDateTime << 32) | ftUser.dwLowDateTime;
+    return (kernel + user) * 100;
+}
+
+
+// Pin the calling thread to a CPU core
+inline static int plt_threadSetAffinity(int cpu)
+{
+    if(SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu) == 0) return (int)GetLastError();
+    return 0;
+}
+
+
+// Closest to real-time FIFO scheduling. Note: The priority value is not used
+inline static int plt_threadSetRealtime(int priority)
+{
+    if(!SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL)) return (int)GetLastError();
+    return 0;
+}
+
+
+// Locking all pages of the process is not available
+inline static int plt_lockMemory()
+{
+    return ERROR_NOT_SUPPORTED;
+}
+
+
+// Sequentially consistent 32 bit load/store (shared between threads without a lock)
+inline static uint32_t plt_atomicLoad32(volatile uint32_t *ptr)
+{
+    return (uint32_t)InterlockedCompareExchange((volatile LONG *)ptr, 0, 0);
+}
+
+
+inline static void plt_atomicStore32(volatile uint32_t *ptr, uint32_t value)
+{
+    InterlockedExchange((volatile LONG *)ptr, (LONG)value);
+}
+
+
+inline static uint32_t plt_atomicExchange32(volatile uint32_t *ptr, uint32_t value)
+{
+    return (uint32_t)InterlockedExchange((volatile LONG *)ptr, (LONG)value);
+}
+
+
+inline static uint32_t plt_atomicAdd32(volatile uint32_t *ptr, uint32_t value)
+{
+    return (uint32_t)InterlockedExchangeAdd((volatile LONG *)ptr, (LONG)value);
+}
+
+
+inline static int plt_atomicCompareExchange32(volatile uint32_t *ptr, uint32_t expected, uint32_t value)
+{
+    return ((uint32_t)InterlockedCompareExchange((volatile LONG *)ptr, (LONG)value, (LONG)expected) == expected) ? 1 : 0;
+}
+
+
+// Named shared memory (between processes), zero-filled when created. Returns 0 on success.
+inline static int plt_shmOpen(PLT_SHM *shm, const char *name, size_t size)
+{
+    char objName[64];
+    _snprintf_s(objName, sizeof(objName), _TRUNCATE, "Local\\idtfPlayer-%s", name);
+
+    // Note: The mapping object lives as long as a process keeps it open
+    shm->handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, (DWORD)size, objName);
+    if(!shm->handle) return (int)GetLastError();
+
+    shm->ptr = MapViewOfFile(shm->handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if(!shm->ptr)
+    {
+        int rc = (int)GetLastError();
+        CloseHandle(shm->handle);
+        return rc;
+    }
+
+    shm->size = size;
+    return 0;
+}
+
+
+inline static void plt_shmClose(PLT_SHM *shm, int removeFlag)
+{
+    if(shm->ptr) UnmapViewOfFile(shm->ptr);
+    if(shm->handle) CloseHandle(shm->handle);
+    shm->ptr = (void *)0;
+    shm->handle = (HANDLE)0;
+}
+
+
+inline static uint32_t plt_getProcessID()
+{
+    return (uint32_t)GetCurrentProcessId();
+}
+
+
+inline static int plt_isProcessAlive(uint32_t pid)
+{
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, (DWORD)pid);
+    if(!process) return GetLastError() == ERROR_ACCESS_DENIED;
+
+    int aliveFlag = (WaitForSingleObject(process, 0) == WAIT_TIMEOUT);
+    CloseHandle(process);
+    return aliveFlag;
+}
+
+
 #endif
 
@@ -0,0 +1,364 @@
+// -------------------------------------------------------------------------------------------------
+//  File script.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Platform includes
+#if defined(_WIN32) || defined(WIN32)
+#include "plt-windows.h"
+#else
+#include "plt-posix.h"
+#endif
+
+// Module header
+#include "script.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define MAX_SCRIPT_LINE                 1024        // Maximum line length of a script
+#define MAX_SCRIPT_ARGS                 8           // Maximum number of words per statement
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+void idnLogError(const char *fmt, ...);
+
+
+// -------------------------------------------------------------------------------------------------
+//  Tools
+// -------------------------------------------------------------------------------------------------
+
+static int findFile(SCRIPT *script, const char *filename)
+{
+    // Each file is decoded once per script, however often it is played
+    for(unsigned i = 0; i < script->fileCnt; i++) if(!strcmp(script->files[i], filename)) return (int)i;
+    if(script->fileCnt == SCRIPT_MAX_FILES) return -1;
+
+    script->files[script->fileCnt] = strdup(filename);
+    if(!script->files[script->fileCnt]) return -1;
+
+    return (int)script->fileCnt++;
+}
+
+
+static int findCue(SCRIPT_CUES *cues, const char *name)
+{
+    // Note: Cue names are shared by all scripts (a cue raised by one script resumes others)
+    for(unsigned i = 0; i < cues->cueCnt; i++) if(!strcmp(cues->names[i], name)) return (int)i;
+    if(cues->cueCnt == SCRIPT_MAX_CUES) return -1;
+
+    cues->names[cues->cueCnt] = strdup(name);
+    if(!cues->names[cues->cueCnt]) return -1;
+
+    return (int)cues->cueCnt++;
+}
+
+
+static uint64_t parseTime(const char *text)
+{
+    // Seconds (fractions allowed) to nanoseconds, 0: invalid
+    double seconds = atof(text);
+    return (seconds > 0.0) ? (uint64_t)(seconds * 1e9) : 0;
+}
+
+
+static void raiseCue(SCRIPT_CUES *cues, unsigned cueIndex)
+{
+    cues->raiseCnt[cueIndex]++;
+
+    // Wake up the scripts waiting (each one registers again if it keeps waiting)
+    SCRIPT_RUN *run = cues->waiters[cueIndex];
+    cues->waiters[cueIndex] = (SCRIPT_RUN *)0;
+    while(run)
+    {
+        SCRIPT_RUN *next = run->nextWaiter;
+        run->nextWaiter = (SCRIPT_RUN *)0;
+        run->waitFlag = 0;
+        if(run->wakeFunc) run->wakeFunc(run->wakeContext);
+        run = next;
+    }
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  API functions
+// -------------------------------------------------------------------------------------------------
+
+int scrLoad(const char *filename, SCRIPT_CUES *cues, SCRIPT *script)
+{
+    memset(script, 0, sizeof(SCRIPT));
+
+    FILE *fp = plt_fopen(filename, "r");
+    if(!fp)
+    {
+        idnLogError("[SCR] Cannot open %s", filename);
+        return -1;
+    }
+
+    script->steps = (SCRIPT_STEP *)calloc(SCRIPT_MAX_STEPS, sizeof(SCRIPT_STEP));
+    if(!script->steps) { idnLogError("[SCR] Insufficient memory"); fclose(fp); return -1; }
+
+    char line[MAX_SCRIPT_LINE];
+    unsigned lineNumber = 0;
+    int waitFlag = 0, rc = 0;
+    while(fgets(line, sizeof(line), fp))
+    {
+        // Split into words. Note: No quoting, file names without blanks.
+        char *argv[MAX_SCRIPT_ARGS];
+        int argc = 0;
+        lineNumber++;
+        for(char *token = strtok(line, " \t\r\n"); token && (argc < MAX_SCRIPT_ARGS); token = strtok((char *)0, " \t\r\n"))
+        {
+            argv[argc++] = token;
+        }
+
+        // Skip empty lines and comments
+        if(!argc || (argv[0][0] == '#')) continue;
+        if(script->stepCnt == SCRIPT_MAX_STEPS)
+        {
+            idnLogError("[SCR] %s, line %u: More than %u statements", filename, lineNumber, SCRIPT_MAX_STEPS);
+            rc = -1;
+            break;
+        }
+
+        SCRIPT_STEP *step = &script->steps[script->stepCnt];
+        step->lineNumber = lineNumber;
+        int index = 0, validFlag = 0;
+        if(!strcmp(argv[0], "play") && (argc >= 2) && ((index = findFile(script, argv[1])) >= 0))
+        {
+            step->op = SCRIPT_OP_PLAY;
+            step->fileIndex = (unsigned)index;
+            if(argc == 2)
+            {
+                step->endMode = SCRIPT_END_FILE;
+                validFlag = 1;
+            }
+            else if((argc == 3) && !strcmp(argv[2], "loop"))
+            {
+                step->endMode = SCRIPT_END_NEVER;
+                validFlag = 1;
+            }
+            else if((argc == 4) && !strcmp(argv[2], "for"))
+            {
+                step->endMode = SCRIPT_END_TIME;
+                step->param = parseTime(argv[3]);
+                validFlag = (step->param != 0);
+            }
+            else if((argc == 4) && !strcmp(argv[2], "times"))
+            {
+                step->endMode = SCRIPT_END_COUNT;
+                step->param = (uint64_t)atoi(argv[3]);
+                validFlag = (step->param != 0);
+            }
+            else if((argc == 4) && !strcmp(argv[2], "until") && ((index = findCue(cues, argv[3])) >= 0))
+            {
+                step->endMode = SCRIPT_END_CUE;
+                step->cueIndex = (unsigned)index;
+                validFlag = 1;
+            }
+            waitFlag = 1;
+        }
+        else if(!strcmp(argv[0], "wait") && (argc == 2))
+        {
+            step->op = SCRIPT_OP_WAIT;
+            step->param = parseTime(argv[1]);
+            validFlag = (step->param != 0);
+            waitFlag = 1;
+        }
+        else if(!strcmp(argv[0], "await") && (argc == 2) && ((index = findCue(cues, argv[1])) >= 0))
+        {
+            step->op = SCRIPT_OP_AWAIT;
+            step->cueIndex = (unsigned)index;
+            validFlag = 1;
+            waitFlag = 1;
+        }
+        else if(!strcmp(argv[0], "cue") && (argc == 2) && ((index = findCue(cues, argv[1])) >= 0))
+        {
+            step->op = SCRIPT_OP_CUE;
+            step->cueIndex = (unsigned)index;
+            validFlag = 1;
+        }
+        else if(!strcmp(argv[0], "stop") && (argc == 1))
+        {
+            step->op = SCRIPT_OP_STOP;
+            validFlag = 1;
+        }
+        else if(!strcmp(argv[0], "repeat") && (argc == 1) && waitFlag)
+        {
+            // Note: Something to wait for before, no endless loop without frames
+            step->op = SCRIPT_OP_REPEAT;
+            validFlag = 1;
+        }
+
+        if(!validFlag)
+        {
+            idnLogError("[SCR] %s, line %u: Invalid statement (play file [for s | times n | until cue | loop], "
+                        "wait s, await cue, cue name, stop, repeat; at most %u files, %u cues)",
+                        filename, lineNumber, SCRIPT_MAX_FILES, SCRIPT_MAX_CUES);
+            rc = -1;
+            break;
+        }
+        script->stepCnt++;
+    }
+    fclose(fp);
+
+    if(!rc && !script->stepCnt) { idnLogError("[SCR] %s: No statements", filename); rc = -1; }
+    if(rc) scrFree(script);
+
+    return rc;
+}
+
+
+void scrFree(SCRIPT *script)
+{
+    for(unsigned i = 0; i < script->fileCnt; i++) free(script->files[i]);
+    if(script->steps) free(script->steps);
+    memset(script, 0, sizeof(SCRIPT));
+}
+
+
+void scrFreeCues(SCRIPT_CUES *cues)
+{
+    for(unsigned i = 0; i < cues->cueCnt; i++) free(cues->names[i]);
+    memset(cues, 0, sizeof(SCRIPT_CUES));
+}
+
+
+void scrInitRun(SCRIPT_RUN *run, const SCRIPT *script, SCRIPT_CUES *cues, uint64_t holdNS)
+{
+    memset(run, 0, sizeof(SCRIPT_RUN));
+    run->script = script;
+    run->cues = cues;
+    run->holdNS = holdNS;
+}
+
+
+int scrResume(SCRIPT_RUN *run, uint64_t now, SCRIPT_AWAIT *await)
+{
+    // Run the statements up to the next one that waits. Note: The state lives in the run (the
+    // statement and its progress), the driver resumes it when the awaited thing happened.
+    const SCRIPT *script = run->script;
+    SCRIPT_CUES *cues = run->cues;
+    while(run->pc < script->stepCnt)
+    {
+        const SCRIPT_STEP *step = &script->steps[run->pc];
+        int startFlag = !run->stepFlag;
+        if(startFlag)
+        {
+            run->stepFlag = 1;
+            run->frameIndex = 0;
+            run->passCnt = 0;
+            run->stepEnd = now + step->param;
+            run->cueMark = cues->raiseCnt[step->cueIndex];
+        }
+
+        if(step->op == SCRIPT_OP_PLAY)
+        {
+            // Next frame (the previous one was sent), the file is looped
+            unsigned frameCnt = run->frameCnts[step->fileIndex];
+            if(!startFlag && (++run->frameIndex >= frameCnt))
+            {
+                run->frameIndex = 0;
+                run->passCnt++;
+            }
+
+            // Note: A single frame played to the end is held (same frame sent for the hold time)
+            int doneFlag = 0;
+            if(step->endMode == SCRIPT_END_FILE)
+            {
+                if(startFlag && (frameCnt == 1)) run->stepEnd = now + run->holdNS;
+                doneFlag = (frameCnt == 1) ? (now >= run->stepEnd) : (run->passCnt != 0);
+            }
+            else if(step->endMode == SCRIPT_END_TIME) doneFlag = (now >= run->stepEnd);
+            else if(step->endMode == SCRIPT_END_COUNT) doneFlag = (run->passCnt >= step->param);
+            else if(step->endMode == SCRIPT_END_CUE) doneFlag = (cues->raiseCnt[step->cueIndex] != run->cueMark);
+
+            if(!doneFlag)
+            {
+                await->fileIndex = step->fileIndex;
+                await->frameIndex = run->frameIndex;
+                return SCRIPT_ACT_FRAME;
+            }
+        }
+        else if(step->op == SCRIPT_OP_WAIT)
+        {
+            if(now < run->stepEnd)
+            {
+                await->time = run->stepEnd;
+                return SCRIPT_ACT_WAIT;
+            }
+        }
+        else if(step->op == SCRIPT_OP_AWAIT)
+        {
+            // Raised since the statement started? Otherwise wait for the next raise.
+            if(cues->raiseCnt[step->cueIndex] == run->cueMark)
+            {
+                if(!run->waitFlag)
+                {
+                    run->nextWaiter = cues->waiters[step->cueIndex];
+                    cues->waiters[step->cueIndex] = run;
+                    run->waitFlag = 1;
+                }
+                await->cueIndex = step->cueIndex;
+                return SCRIPT_ACT_CUE;
+            }
+        }
+        else if(step->op == SCRIPT_OP_CUE)
+        {
+            raiseCue(cues, step->cueIndex);
+        }
+        else if(step->op == SCRIPT_OP_STOP)
+        {
+            // Channel closed by the driver, continue on the next resume
+            if(startFlag) return SCRIPT_ACT_STOP;
+        }
+        else if(step->op == SCRIPT_OP_REPEAT)
+        {
+            run->pc = 0;
+            run->stepFlag = 0;
+            continue;
+        }
+
+        // Statement done
+        run->pc++;
+        run->stepFlag = 0;
+    }
+
+    return SCRIPT_ACT_END;
+}
@@ -0,0 +1,152 @@
+// -------------------------------------------------------------------------------------------------
+//  File script.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define SCRIPT_MAX_STEPS                256         // Maximum number of statements per script
+#define SCRIPT_MAX_FILES                16          // Maximum number of IDTF files per script
+#define SCRIPT_MAX_CUES                 32          // Maximum number of cue names (all scripts)
+
+#define SCRIPT_OP_PLAY                  1           // Play a file (see SCRIPT_END_*)
+#define SCRIPT_OP_WAIT                  2           // Keep the channel open without frames for a time
+#define SCRIPT_OP_AWAIT                 3           // Keep the channel open without frames until a cue
+#define SCRIPT_OP_CUE                   4           // Raise a cue
+#define SCRIPT_OP_STOP                  5           // Close the channel
+#define SCRIPT_OP_REPEAT                6           // Start over with the first statement
+
+#define SCRIPT_END_FILE                 0           // Play: Until the end of the file (single frame: hold time)
+#define SCRIPT_END_TIME                 1           // Play: For a time, file looped
+#define SCRIPT_END_COUNT                2           // Play: Number of times through the file
+#define SCRIPT_END_CUE                  3           // Play: Until a cue, file looped
+#define SCRIPT_END_NEVER                4           // Play: Loop the file forever
+
+#define SCRIPT_ACT_FRAME                1           // Send the given frame at its deadline, resume after
+#define SCRIPT_ACT_WAIT                 2           // Resume at the given time (no frames, keepalive)
+#define SCRIPT_ACT_CUE                  3           // Resume when woken up by the cue (no frames, keepalive)
+#define SCRIPT_ACT_STOP                 4           // Close the channel, resume right away
+#define SCRIPT_ACT_END                  5           // Script over, close the session
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct _SCRIPT_RUN SCRIPT_RUN;
+
+typedef void (* SCRIPT_WAKE_FUNC)(void *context);
+
+typedef struct
+{
+    int op;                                 // Statement (see SCRIPT_OP_*)
+    int endMode;                            // End of a play statement (see SCRIPT_END_*)
+    unsigned fileIndex;                     // File played
+    unsigned cueIndex;                      // Cue raised or waited for
+    uint64_t param;                         // Time (ns) or number of times through the file
+    unsigned lineNumber;                    // Line of the statement (messages)
+
+} SCRIPT_STEP;
+
+typedef struct
+{
+    SCRIPT_STEP *steps;                     // Statements
+    unsigned stepCnt;                       // Number of statements
+    char *files[SCRIPT_MAX_FILES];          // IDTF files played (each one once)
+    unsigned fileCnt;                       // Number of files
+
+} SCRIPT;
+
+typedef struct
+{
+    char *names[SCRIPT_MAX_CUES];           // Cue names (shared by all scripts of a loop)
+    uint32_t raiseCnt[SCRIPT_MAX_CUES];     // Number of times raised
+    SCRIPT_RUN *waiters[SCRIPT_MAX_CUES];   // Scripts waiting (woken up once on the next raise)
+    unsigned cueCnt;                        // Number of cue names
+
+} SCRIPT_CUES;
+
+struct _SCRIPT_RUN
+{
+    const SCRIPT *script;                   // Script run
+    SCRIPT_CUES *cues;                      // Cues of the loop
+    unsigned frameCnts[SCRIPT_MAX_FILES];   // Number of frames per file (set by the driver)
+    uint64_t holdNS;                        // Hold time for single-frame files played to the end
+    SCRIPT_WAKE_FUNC wakeFunc;              // Resume a script waiting for a cue
+    void *wakeContext;                      // Wakeup callback context
+
+    unsigned pc;                            // Statement run
+    int stepFlag;                           // Statement started
+    unsigned frameIndex;                    // Frame of the file sent last
+    uint32_t passCnt;                       // Number of times through the file
+    uint64_t stepEnd;                       // End time of the statement
+    uint32_t cueMark;                       // Raise count of the cue when the statement started
+    SCRIPT_RUN *nextWaiter;                 // Next script waiting for the same cue
+    int waitFlag;                           // Registered as waiter
+
+};
+
+typedef struct
+{
+    unsigned fileIndex;                     // SCRIPT_ACT_FRAME: File
+    unsigned frameIndex;                    // SCRIPT_ACT_FRAME: Frame of the file
+    uint64_t time;                          // SCRIPT_ACT_WAIT: Time to resume
+    unsigned cueIndex;                      // SCRIPT_ACT_CUE: Cue waited for
+
+} SCRIPT_AWAIT;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+// Note: A script is a list of statements, one per line (# comments):
+//   play file [for seconds | times n | until cue | loop]
+//   wait seconds | await cue | cue name | stop | repeat
+// A running script is a state machine resumed by its driver: Each resume runs the statements up to
+// the next thing to wait for (frame deadline, time, cue) and returns it. Many scripts run
+// cooperatively in one event loop thread, a raised cue takes effect at the next frame boundary.
+int scrLoad(const char *filename, SCRIPT_CUES *cues, SCRIPT *script);
+void scrFree(SCRIPT *script);
+void scrFreeCues(SCRIPT_CUES *cues);
+
+void scrInitRun(SCRIPT_RUN *run, const SCRIPT *script, SCRIPT_CUES *cues, uint64_t holdNS);
+int scrResume(SCRIPT_RUN *run, uint64_t now, SCRIPT_AWAIT *await);
+
+
+#endif
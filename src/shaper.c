@@ -0,0 +1,204 @@
+// -------------------------------------------------------------------------------------------------
+//  File shaper.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Module header
+#include "shaper.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+// Tokens are kept in bytes * 10^9, so that one nanosecond at the fill rate adds 'rate' tokens
+#define TOKEN_SCALE                     1000000000ll
+
+
+// -------------------------------------------------------------------------------------------------
+//  Tools
+// -------------------------------------------------------------------------------------------------
+
+static void initBucket(SHAPER_BUCKET *bucket, uint64_t bytesPerSec, unsigned burst)
+{
+    // Default burst: 2 ms at the fill rate, but at least one maximum size datagram
+    if(burst == 0) burst = (unsigned)(bytesPerSec / 500);
+    if(burst < SHAPER_MIN_BURST) burst = SHAPER_MIN_BURST;
+
+    bucket->rate = bytesPerSec;
+    bucket->depth = (int64_t)burst * TOKEN_SCALE;
+    bucket->tokens = bucket->depth;
+    bucket->lastTime = 0;
+}
+
+
+static uint64_t bucketReserve(SHAPER_BUCKET *bucket, uint64_t rate, unsigned length, uint64_t now)
+{
+    if(rate == 0) return 0;
+
+    // Refill (first use: start with a full bucket). Long idle times fill up (no overflow).
+    if((bucket->lastTime != 0) && (now > bucket->lastTime))
+    {
+        uint64_t elapsed = now - bucket->lastTime;
+        if(elapsed > (uint64_t)(bucket->depth / (int64_t)rate)) bucket->tokens = bucket->depth;
+        else bucket->tokens += (int64_t)elapsed * (int64_t)rate;
+        if(bucket->tokens > bucket->depth) bucket->tokens = bucket->depth;
+    }
+    bucket->lastTime = now;
+
+    // Debit in advance. In case of debt, the datagram has to wait until it is paid off.
+    bucket->tokens -= (int64_t)length * TOKEN_SCALE;
+    if(bucket->tokens >= 0) return 0;
+
+    return (uint64_t)((-bucket->tokens + (int64_t)rate - 1) / (int64_t)rate);
+}
+
+
+static void updateActive(SHAPER_LINK *link, uint64_t now)
+{
+    // Streams that did not send for a while do not take their share of the link
+    unsigned activeCnt = 0;
+    for(SHAPER_STREAM *stream = link->streamList; stream; stream = stream->next)
+    {
+        stream->activeFlag = stream->activeFlag && ((now - stream->lastActive) < SHAPER_ACTIVE_TIMEOUT);
+        if(stream->activeFlag) activeCnt++;
+    }
+    link->activeCnt = activeCnt;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  API functions
+// -------------------------------------------------------------------------------------------------
+
+void shpInitLink(SHAPER_LINK *link, uint64_t bytesPerSec, unsigned burst)
+{
+    memset(link, 0, sizeof(*link));
+    initBucket(&link->bucket, bytesPerSec, burst);
+}
+
+
+void shpInitStream(SHAPER_STREAM *stream, SHAPER_LINK *link, uint64_t bytesPerSec, unsigned burst)
+{
+    memset(stream, 0, sizeof(*stream));
+    initBucket(&stream->bucket, bytesPerSec, burst);
+    stream->configRate = bytesPerSec;
+
+    // Attach to the shared link
+    stream->link = link;
+    if(link)
+    {
+        stream->next = link->streamList;
+        link->streamList = stream;
+    }
+}
+
+
+void shpCloneStream(SHAPER_STREAM *stream, const SHAPER_STREAM *tmpl)
+{
+    // Same target limit on the same link, own bucket and statistics
+    shpInitStream(stream, tmpl->link, tmpl->configRate, (unsigned)(tmpl->bucket.depth / TOKEN_SCALE));
+}
+
+
+void shpDetachStream(SHAPER_STREAM *stream)
+{
+    SHAPER_LINK *link = stream->link;
+    if(!link) return;
+
+    for(SHAPER_STREAM **pp = &link->streamList; *pp; pp = &(*pp)->next)
+    {
+        if(*pp == stream) { *pp = stream->next; break; }
+    }
+    if(stream->activeFlag && link->activeCnt) link->activeCnt--;
+
+    stream->link = (SHAPER_LINK *)0;
+    stream->next = (SHAPER_STREAM *)0;
+}
+
+
+uint64_t shpReserve(SHAPER_STREAM *stream, unsigned length, uint64_t now)
+{
+    SHAPER_LINK *link = stream->link;
+    stream->byteCnt += length;
+
+    // Effective stream rate: The configured target rate, limited to a fair share of the link
+    uint64_t rate = stream->configRate;
+    if(link && link->bucket.rate)
+    {
+        if(!stream->activeFlag) { stream->activeFlag = 1; link->activeCnt++; }
+        updateActive(link, now);
+
+        uint64_t share = link->bucket.rate / (link->activeCnt ? link->activeCnt : 1);
+        if((rate == 0) || (share < rate)) rate = share;
+    }
+    stream->lastActive = now;
+
+    // Datagrams are reserved in send order, so fragments of a frame never overtake each other
+    uint64_t nsWait = bucketReserve(&stream->bucket, rate, length, now);
+    if(link)
+    {
+        uint64_t nsLinkWait = bucketReserve(&link->bucket, link->bucket.rate, length, now);
+        if(nsLinkWait > nsWait) nsWait = nsLinkWait;
+    }
+
+    if(nsWait)
+    {
+        stream->delayedCnt++;
+        stream->delaySum += nsWait;
+        if(nsWait > stream->delayMax) stream->delayMax = nsWait;
+    }
+
+    return nsWait;
+}
+
+
+int shpParseRate(const char *str, uint64_t *bytesPerSec, unsigned *burst)
+{
+    // Format: <Mbit/s>[:<burst bytes>]
+    char *end;
+    double mbps = strtod(str, &end);
+    if((end == str) || (mbps <= 0.0)) return -1;
+
+    *burst = 0;
+    if(*end == ':')
+    {
+        long param = strtol(end + 1, &end, 10);
+        if(param <= 0) return -1;
+        *burst = (unsigned)param;
+    }
+    if(*end != 0) return -1;
+
+    *bytesPerSec = (uint64_t)(mbps * 1000000.0 / 8.0);
+    return 0;
+}
@@ -0,0 +1,103 @@
+// -------------------------------------------------------------------------------------------------
+//  File shaper.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+
+#ifndef SHAPER_H
+#define SHAPER_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define SHAPER_ACTIVE_TIMEOUT           100000000   // Stream is idle after 100 ms without data (ns)
+#define SHAPER_MIN_BURST                0x10000     // Minimum bucket depth (one maximum datagram)
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    uint64_t rate;                          // Fill rate in bytes per second, 0: unlimited
+    int64_t depth;                          // Bucket depth (burst size), scaled
+    int64_t tokens;                         // Current fill level, scaled (negative: debt)
+    uint64_t lastTime;                      // Time of the last update (nanoseconds)
+
+} SHAPER_BUCKET;
+
+
+typedef struct _SHAPER_STREAM SHAPER_STREAM;
+
+typedef struct
+{
+    SHAPER_BUCKET bucket;                   // Aggregate limit of the link (uplink)
+    SHAPER_STREAM *streamList;              // Streams sharing the link
+    unsigned activeCnt;                     // Number of streams that recently sent data
+
+} SHAPER_LINK;
+
+
+struct _SHAPER_STREAM
+{
+    SHAPER_BUCKET bucket;                   // Limit of the target
+    uint64_t configRate;                    // Configured target rate in bytes per second, 0: none
+    SHAPER_LINK *link;                      // Shared link, null: none
+    SHAPER_STREAM *next;                    // Next stream on the link
+    uint64_t lastActive;                    // Time of the last datagram (nanoseconds)
+    int activeFlag;                         // Stream counted as active on the link
+
+    uint64_t byteCnt;                       // Number of bytes passed
+    uint64_t delayedCnt;                    // Number of datagrams delayed
+    uint64_t delaySum;                      // Sum of all delays in nanoseconds
+    uint64_t delayMax;                      // Maximum delay in nanoseconds
+};
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+void shpInitLink(SHAPER_LINK *link, uint64_t bytesPerSec, unsigned burst);
+void shpInitStream(SHAPER_STREAM *stream, SHAPER_LINK *link, uint64_t bytesPerSec, unsigned burst);
+void shpCloneStream(SHAPER_STREAM *stream, const SHAPER_STREAM *tmpl);
+void shpDetachStream(SHAPER_STREAM *stream);
+
+uint64_t shpReserve(SHAPER_STREAM *stream, unsigned length, uint64_t now);
+
+int shpParseRate(const char *str, uint64_t *bytesPerSec, unsigned *burst);
+
+
+#endif
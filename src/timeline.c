@@ -0,0 +1,348 @@
+// -------------------------------------------------------------------------------------------------
+//  File timeline.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+// Platform includes
+#if defined(_WIN32) || defined(WIN32)
+
+    #include <windows.h>
+
+    #include "plt-windows.h"
+
+#else
+
+    #include "plt-posix.h"
+
+#endif
+
+
+// Module header
+#include "timeline.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define TIMELINE_MAX_MEMBERS            64          // Maximum number of processes on a shared timeline
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    uint64_t frameNumber;                   // Frame index + 1, 0: unused
+    int64_t offsetMin;                      // Earliest send time relative to the deadline (ns)
+    int64_t offsetMax;                      // Latest send time relative to the deadline (ns)
+    uint32_t targetCnt;                     // Number of targets that sent the frame
+
+} TIMELINE_SLOT;
+
+
+typedef struct
+{
+    // Note: Same layout in all processes (shared memory), zero-filled when created
+    volatile uint32_t lock;                 // Spin lock (short critical sections only)
+    uint32_t memberCnt;                     // Number of processes on the timeline
+    uint32_t members[TIMELINE_MAX_MEMBERS]; // Process IDs of the members, 0: free
+    uint32_t frameRate;                     // Frames per second
+    uint64_t epoch;                         // Monotonic time of frame 0 (ns)
+
+    TIMELINE_SLOT slots[TIMELINE_SLOTS];
+    TIMELINE_STATS stats;
+
+} TIMELINE_SHARED;
+
+
+struct _TIMELINE
+{
+    TIMELINE_SHARED *shared;                // Local memory or shared memory mapping
+    PLT_SHM shm;                            // Shared memory (named timeline)
+    int shmFlag;                            // Named timeline
+};
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+void idnLogError(const char *fmt, ...);
+void idnLogInfo(const char *fmt, ...);
+
+
+// -------------------------------------------------------------------------------------------------
+//  Tools
+// -------------------------------------------------------------------------------------------------
+
+static void lockShared(TIMELINE_SHARED *shared)
+{
+    while(plt_atomicExchange32(&shared->lock, 1)) { }
+}
+
+
+static void unlockShared(TIMELINE_SHARED *shared)
+{
+    plt_atomicStore32(&shared->lock, 0);
+}
+
+
+static void foldSlot(TIMELINE_SHARED *shared, TIMELINE_SLOT *slot)
+{
+    // Spread of the send times of one frame across the targets
+    if(slot->targetCnt >= 2)
+    {
+        uint64_t skew = (uint64_t)(slot->offsetMax - slot->offsetMin);
+        shared->stats.frameCnt++;
+        shared->stats.skewSum += skew;
+        if(skew > shared->stats.skewMax) shared->stats.skewMax = skew;
+    }
+    if(slot->targetCnt > shared->stats.targetMax) shared->stats.targetMax = slot->targetCnt;
+
+    memset(slot, 0, sizeof(*slot));
+}
+
+
+static void startShared(TIMELINE_SHARED *shared, unsigned frameRate, uint64_t startDelay)
+{
+    // New timeline: Frame 0 after the start delay, no statistics
+    memset(shared->slots, 0, sizeof(shared->slots));
+    memset(&shared->stats, 0, sizeof(shared->stats));
+    shared->frameRate = frameRate;
+    shared->epoch = plt_getMonoTimeNS() + startDelay;
+}
+
+
+static unsigned pruneMembers(TIMELINE_SHARED *shared)
+{
+    // Members gone without leaving (killed, crashed): Removed. Returns the number removed.
+    unsigned deadCnt = 0, memberCnt = 0;
+    for(unsigned i = 0; i < TIMELINE_MAX_MEMBERS; i++)
+    {
+        if(!shared->members[i]) continue;
+        if(plt_isProcessAlive(shared->members[i])) { memberCnt++; continue; }
+
+        shared->members[i] = 0;
+        deadCnt++;
+    }
+
+    shared->memberCnt = memberCnt;
+    return deadCnt;
+}
+
+
+static int putMember(TIMELINE_SHARED *shared, uint32_t pid, int joinFlag)
+{
+    // Join (pid added) or leave (pid removed). Returns -1 when the timeline is full.
+    for(unsigned i = 0; i < TIMELINE_MAX_MEMBERS; i++)
+    {
+        if(shared->members[i] != (joinFlag ? 0 : pid)) continue;
+
+        shared->members[i] = joinFlag ? pid : 0;
+        if(joinFlag) shared->memberCnt++;
+        else shared->memberCnt--;
+        return 0;
+    }
+
+    return joinFlag ? -1 : 0;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  API functions
+// -------------------------------------------------------------------------------------------------
+
+TIMELINE *tmlCreate(unsigned frameRate, uint64_t startDelay)
+{
+    TIMELINE *tml = (TIMELINE *)calloc(1, sizeof(TIMELINE));
+    if(!tml) return (TIMELINE *)0;
+
+    tml->shared = (TIMELINE_SHARED *)calloc(1, sizeof(TIMELINE_SHARED));
+    if(!tml->shared) { free(tml); return (TIMELINE *)0; }
+
+    startShared(tml->shared, frameRate, startDelay);
+    tml->shared->memberCnt = 1;
+
+    return tml;
+}
+
+
+TIMELINE *tmlAttach(const char *name, unsigned frameRate, uint64_t startDelay)
+{
+    TIMELINE *tml = (TIMELINE *)calloc(1, sizeof(TIMELINE));
+    if(!tml) return (TIMELINE *)0;
+
+    int rc = plt_shmOpen(&tml->shm, name, sizeof(TIMELINE_SHARED));
+    if(rc)
+    {
+        idnLogError("[TML] Shared memory for timeline '%s' not available (error: %d)", name, rc);
+        free(tml);
+        return (TIMELINE *)0;
+    }
+    tml->shared = (TIMELINE_SHARED *)tml->shm.ptr;
+    tml->shmFlag = 1;
+
+    // First process starts the timeline, a stale one (all members gone, also killed ones which
+    // never left) is restarted. Note: A process joining late keeps the epoch of the running members
+    // and starts with the next frame due (see tmlGetNextFrame()).
+    TIMELINE_SHARED *shared = tml->shared;
+    lockShared(shared);
+    unsigned deadCnt = pruneMembers(shared);
+    int joinFlag = (shared->memberCnt != 0);
+    if(shared->memberCnt && (shared->frameRate != frameRate)) rc = -1;
+    else if(!joinFlag) startShared(shared, frameRate, startDelay);
+    if(!rc && putMember(shared, plt_getProcessID(), 1)) rc = -2;
+    uint64_t epoch = shared->epoch;
+    unsigned memberCnt = shared->memberCnt;
+    unlockShared(shared);
+
+    if(deadCnt) idnLogInfo("[TML] Timeline '%s': %u processes gone without leaving, removed", name, deadCnt);
+    if(rc)
+    {
+        if(rc == -2) idnLogError("[TML] Timeline '%s' has %u processes already", name, TIMELINE_MAX_MEMBERS);
+        else idnLogError("[TML] Timeline '%s' runs at %u frames per second", name, shared->frameRate);
+        plt_shmClose(&tml->shm, 0);
+        free(tml);
+        return (TIMELINE *)0;
+    }
+
+    int64_t startIn = (int64_t)(epoch - plt_getMonoTimeNS());
+    idnLogInfo("[TML] %s timeline '%s' (%u processes), frame 0 %s %u ms", joinFlag ? "Joined" : "Started", name,
+               memberCnt, (startIn >= 0) ? "in" : "was", (unsigned)(((startIn < 0) ? -startIn : startIn) / 1000000));
+
+    return tml;
+}
+
+
+void tmlClose(TIMELINE *tml)
+{
+    if(!tml) return;
+
+    if(!tml->shmFlag)
+    {
+        free(tml->shared);
+        free(tml);
+        return;
+    }
+
+    // Last process leaving: Remove the shared memory
+    lockShared(tml->shared);
+    putMember(tml->shared, plt_getProcessID(), 0);
+    pruneMembers(tml->shared);
+    unsigned memberCnt = tml->shared->memberCnt;
+    unlockShared(tml->shared);
+
+    plt_shmClose(&tml->shm, memberCnt == 0);
+    free(tml);
+}
+
+
+uint64_t tmlGetEpoch(TIMELINE *tml)
+{
+    return tml->shared->epoch;
+}
+
+
+uint64_t tmlGetDeadline(TIMELINE *tml, uint64_t frameIndex)
+{
+    return tml->shared->epoch + ((frameIndex * 1000000000ull) / tml->shared->frameRate);
+}
+
+
+uint64_t tmlGetNextFrame(TIMELINE *tml, uint64_t now)
+{
+    // First frame due at or after the given time (late joiner), 0 before the epoch
+    TIMELINE_SHARED *shared = tml->shared;
+    if(now <= shared->epoch) return 0;
+
+    return (((now - shared->epoch) * shared->frameRate) + 999999999ull) / 1000000000ull;
+}
+
+
+void tmlPutFrame(TIMELINE *tml, uint64_t frameIndex, int64_t offset)
+{
+    TIMELINE_SHARED *shared = tml->shared;
+    TIMELINE_SLOT *slot = &shared->slots[frameIndex % TIMELINE_SLOTS];
+
+    lockShared(shared);
+
+    // Slot taken by an older frame: Complete, take its skew (late frames of the old one are ignored)
+    if(slot->frameNumber != frameIndex + 1)
+    {
+        if(slot->frameNumber > frameIndex + 1) { unlockShared(shared); return; }
+        if(slot->frameNumber) foldSlot(shared, slot);
+
+        slot->frameNumber = frameIndex + 1;
+        slot->offsetMin = offset;
+        slot->offsetMax = offset;
+    }
+
+    if(offset < slot->offsetMin) slot->offsetMin = offset;
+    if(offset > slot->offsetMax) slot->offsetMax = offset;
+    slot->targetCnt++;
+
+    unlockShared(shared);
+}
+
+
+void tmlGetStats(TIMELINE *tml, TIMELINE_STATS *stats)
+{
+    TIMELINE_SHARED *shared = tml->shared;
+
+    // Note: Frames still in the slots are included (the last frames of the show)
+    lockShared(shared);
+    TIMELINE_SLOT slots[TIMELINE_SLOTS];
+    memcpy(slots, shared->slots, sizeof(slots));
+    TIMELINE_STATS total = shared->stats;
+    total.memberCnt = shared->memberCnt;
+    unlockShared(shared);
+
+    for(unsigned i = 0; i < TIMELINE_SLOTS; i++)
+    {
+        TIMELINE_SLOT *slot = &slots[i];
+        if(slot->targetCnt >= 2)
+        {
+            uint64_t skew = (uint64_t)(slot->offsetMax - slot->offsetMin);
+            total.frameCnt++;
+            total.skewSum += skew;
+            if(skew > total.skewMax) total.skewMax = skew;
+        }
+        if(slot->targetCnt > total.targetMax) total.targetMax = slot->targetCnt;
+    }
+
+    *stats = total;
+}
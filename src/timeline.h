@@ -0,0 +1,84 @@
+// -------------------------------------------------------------------------------------------------
+//  File timeline.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define TIMELINE_SLOTS                  64          // Frames tracked at a time for the skew measurement
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct _TIMELINE TIMELINE;
+
+typedef struct
+{
+    unsigned memberCnt;                     // Number of processes on the timeline (shared timeline)
+    unsigned targetMax;                     // Maximum number of targets that sent the same frame
+    uint64_t frameCnt;                      // Number of frames sent by at least two targets
+    uint64_t skewSum;                       // Sum of the send time spread per frame (ns)
+    uint64_t skewMax;                       // Maximum send time spread of a frame (ns)
+
+} TIMELINE_STATS;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+// Note: Frame k of all targets is due at epoch + k * period. A local timeline is used by the threads
+// of one process, a named timeline lives in shared memory. The first process on a named timeline
+// sets the epoch, later ones join it (late ones start with the next frame due). Monotonic time is
+// common to all processes of a host.
+TIMELINE *tmlCreate(unsigned frameRate, uint64_t startDelay);
+TIMELINE *tmlAttach(const char *name, unsigned frameRate, uint64_t startDelay);
+void tmlClose(TIMELINE *tml);
+
+uint64_t tmlGetEpoch(TIMELINE *tml);
+uint64_t tmlGetDeadline(TIMELINE *tml, uint64_t frameIndex);
+uint64_t tmlGetNextFrame(TIMELINE *tml, uint64_t now);
+
+// Note: Thread-safe, offset is the send time relative to the frame deadline
+void tmlPutFrame(TIMELINE *tml, uint64_t frameIndex, int64_t offset);
+void tmlGetStats(TIMELINE *tml, TIMELINE_STATS *stats);
+
+
+#endif
@@ -0,0 +1,425 @@
+// -------------------------------------------------------------------------------------------------
+//  File tx-uring.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+// Standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+// Platform includes
+#if defined(__linux__)
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#endif
+
+// Module header
+#include "tx-uring.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+void idnLogError(const char *fmt, ...);
+void idnLogInfo(const char *fmt, ...);
+
+
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+struct _TXURING
+{
+    int fdRing;                             // io_uring file descriptor
+    int fdSocket;                           // Connected datagram socket
+    int zeroCopy;                           // Use IORING_OP_SEND_ZC with registered buffers
+
+    // Submission queue (shared with the kernel)
+    unsigned *sqHead, *sqTail, *sqMask, *sqArray;
+    struct io_uring_sqe *sqes;
+    unsigned sqPending;                     // Number of queued, not yet submitted entries
+
+    // Completion queue (shared with the kernel)
+    unsigned *cqHead, *cqTail, *cqMask;
+    struct io_uring_cqe *cqes;
+
+    // Ring memory mappings
+    void *sqRingPtr, *cqRingPtr, *sqesPtr;
+    size_t sqRingLen, cqRingLen, sqesLen;
+
+    // Registered datagram buffers (slots) and free slot stack
+    uint8_t *slotMem;
+    unsigned slotCount;
+    unsigned *freeSlots;
+    unsigned freeCnt;
+
+    TXURING_STATS stats;
+};
+
+
+// -------------------------------------------------------------------------------------------------
+//  Tools
+// -------------------------------------------------------------------------------------------------
+
+static int uringSetup(unsigned entries, struct io_uring_params *params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+
+static int uringEnter(int fdRing, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return (int)syscall(__NR_io_uring_enter, fdRing, toSubmit, minComplete, flags, NULL, 0);
+}
+
+
+static int uringRegister(int fdRing, unsigned opcode, void *arg, unsigned argCount)
+{
+    return (int)syscall(__NR_io_uring_register, fdRing, opcode, arg, argCount);
+}
+
+
+static void releaseRing(TXURING *txu)
+{
+    if(txu->sqesPtr) munmap(txu->sqesPtr, txu->sqesLen);
+    if(txu->cqRingPtr && (txu->cqRingPtr != txu->sqRingPtr)) munmap(txu->cqRingPtr, txu->cqRingLen);
+    if(txu->sqRingPtr) munmap(txu->sqRingPtr, txu->sqRingLen);
+    if(txu->fdRing >= 0) close(txu->fdRing);
+    if(txu->slotMem) munmap(txu->slotMem, (size_t)txu->slotCount * TXURING_SLOT_SIZE);
+    if(txu->freeSlots) free(txu->freeSlots);
+    free(txu);
+}
+
+
+static void reapCompletions(TXURING *txu)
+{
+    unsigned head = *txu->cqHead;
+    unsigned tail = __atomic_load_n(txu->cqTail, __ATOMIC_ACQUIRE);
+
+    while(head != tail)
+    {
+        struct io_uring_cqe *cqe = &txu->cqes[head & *txu->cqMask];
+        unsigned slot = (unsigned)cqe->user_data;
+        int slotDone = 1;
+
+        if(cqe->flags & IORING_CQE_F_NOTIF)
+        {
+            // Zero-copy notification: The kernel does not reference the buffer any longer
+            if(cqe->res & IORING_NOTIF_USAGE_ZC_COPIED) txu->stats.copiedCnt++;
+        }
+        else
+        {
+            if(cqe->res < 0)
+            {
+                // Zero-copy not supported for this socket/kernel: Continue with regular sends
+                if(txu->zeroCopy && ((cqe->res == -EINVAL) || (cqe->res == -EOPNOTSUPP)))
+                {
+                    idnLogError("[TXU] Zero-copy send not supported, using regular sends");
+                    txu->zeroCopy = 0;
+                }
+                else if(txu->stats.errorCnt++ == 0)
+                {
+                    idnLogError("[TXU] send failed (error: %d)", -cqe->res);
+                }
+                txu->stats.lastError = -cqe->res;
+            }
+            else
+            {
+                txu->stats.sendCnt++;
+            }
+
+            // Zero-copy sends post a notification when the buffer is released
+            if(cqe->flags & IORING_CQE_F_MORE) slotDone = 0;
+        }
+
+        if(slotDone && (slot < txu->slotCount)) txu->freeSlots[txu->freeCnt++] = slot;
+        head++;
+    }
+
+    __atomic_store_n(txu->cqHead, head, __ATOMIC_RELEASE);
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  API functions
+// -------------------------------------------------------------------------------------------------
+
+TXURING *txuOpen(int fdSocket, unsigned slotCount, int zeroCopy)
+{
+    TXURING *txu = (TXURING *)calloc(1, sizeof(TXURING));
+    if(!txu) return (TXURING *)0;
+    txu->fdRing = -1;
+    txu->fdSocket = fdSocket;
+    txu->zeroCopy = zeroCopy;
+    txu->slotCount = slotCount;
+
+    do
+    {
+        // Setup the ring. Note: Completion queue is twice the size (zero-copy notifications)
+        struct io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        txu->fdRing = uringSetup(slotCount, &params);
+        if(txu->fdRing < 0)
+        {
+            idnLogError("[TXU] io_uring_setup() failed (error: %d)", errno);
+            break;
+        }
+
+        // Map submission queue ring and completion queue ring (single mapping if supported)
+        txu->sqRingLen = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        txu->cqRingLen = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+        if(params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            if(txu->cqRingLen > txu->sqRingLen) txu->sqRingLen = txu->cqRingLen;
+            txu->cqRingLen = txu->sqRingLen;
+        }
+
+        void *ptr = mmap(0, txu->sqRingLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, txu->fdRing, IORING_OFF_SQ_RING);
+        if(ptr == MAP_FAILED) { idnLogError("[TXU] mmap() failed (error: %d)", errno); break; }
+        txu->sqRingPtr = ptr;
+
+        if(params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            txu->cqRingPtr = txu->sqRingPtr;
+        }
+        else
+        {
+            ptr = mmap(0, txu->cqRingLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, txu->fdRing, IORING_OFF_CQ_RING);
+            if(ptr == MAP_FAILED) { idnLogError("[TXU] mmap() failed (error: %d)", errno); break; }
+            txu->cqRingPtr = ptr;
+        }
+
+        txu->sqesLen = params.sq_entries * sizeof(struct io_uring_sqe);
+        ptr = mmap(0, txu->sqesLen, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, txu->fdRing, IORING_OFF_SQES);
+        if(ptr == MAP_FAILED) { idnLogError("[TXU] mmap() failed (error: %d)", errno); break; }
+        txu->sqesPtr = ptr;
+        txu->sqes = (struct io_uring_sqe *)ptr;
+
+        uint8_t *sq = (uint8_t *)txu->sqRingPtr;
+        txu->sqHead = (unsigned *)(sq + params.sq_off.head);
+        txu->sqTail = (unsigned *)(sq + params.sq_off.tail);
+        txu->sqMask = (unsigned *)(sq + params.sq_off.ring_mask);
+        txu->sqArray = (unsigned *)(sq + params.sq_off.array);
+
+        uint8_t *cq = (uint8_t *)txu->cqRingPtr;
+        txu->cqHead = (unsigned *)(cq + params.cq_off.head);
+        txu->cqTail = (unsigned *)(cq + params.cq_off.tail);
+        txu->cqMask = (unsigned *)(cq + params.cq_off.ring_mask);
+        txu->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+
+        // Check the kernel for the send operations
+        size_t probeLen = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+        struct io_uring_probe *probe = (struct io_uring_probe *)calloc(1, probeLen);
+        if(!probe) { idnLogError("[TXU] Insufficient buffer memory"); break; }
+        int sendSupported = 0;
+        if(uringRegister(txu->fdRing, IORING_REGISTER_PROBE, probe, 256) >= 0)
+        {
+            sendSupported = (probe->last_op >= IORING_OP_SEND) && (probe->ops[IORING_OP_SEND].flags & IO_URING_OP_SUPPORTED);
+            int zcSupported = (probe->last_op >= IORING_OP_SEND_ZC) && (probe->ops[IORING_OP_SEND_ZC].flags & IO_URING_OP_SUPPORTED);
+            if(txu->zeroCopy && !zcSupported)
+            {
+                idnLogError("[TXU] Zero-copy send not supported by the kernel, using regular sends");
+                txu->zeroCopy = 0;
+            }
+        }
+        free(probe);
+        if(!sendSupported) { idnLogError("[TXU] io_uring send not supported by the kernel"); break; }
+
+        // Allocate slot memory (page aligned, prefaulted) and the free slot stack
+        size_t slotMemLen = (size_t)slotCount * TXURING_SLOT_SIZE;
+        ptr = mmap(0, slotMemLen, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+        if(ptr == MAP_FAILED) { idnLogError("[TXU] Insufficient buffer memory"); break; }
+        txu->slotMem = (uint8_t *)ptr;
+
+        txu->freeSlots = (unsigned *)malloc(slotCount * sizeof(unsigned));
+        if(!txu->freeSlots) { idnLogError("[TXU] Insufficient buffer memory"); break; }
+        for(unsigned i = 0; i < slotCount; i++) txu->freeSlots[i] = (slotCount - 1) - i;
+        txu->freeCnt = slotCount;
+
+        // Register the slots as fixed buffers (pinned once instead of on every send)
+        struct iovec *iovecs = (struct iovec *)malloc(slotCount * sizeof(struct iovec));
+        if(!iovecs) { idnLogError("[TXU] Insufficient buffer memory"); break; }
+        for(unsigned i = 0; i < slotCount; i++)
+        {
+            iovecs[i].iov_base = &txu->slotMem[(size_t)i * TXURING_SLOT_SIZE];
+            iovecs[i].iov_len = TXURING_SLOT_SIZE;
+        }
+        int rcRegister = uringRegister(txu->fdRing, IORING_REGISTER_BUFFERS, iovecs, slotCount);
+        free(iovecs);
+        if(rcRegister < 0)
+        {
+            if(txu->zeroCopy) idnLogError("[TXU] Buffer registration failed (error: %d), zero-copy disabled", errno);
+            txu->zeroCopy = 0;
+        }
+
+        txu->stats.zeroCopy = txu->zeroCopy;
+        return txu;
+    }
+    while(0);
+
+    releaseRing(txu);
+    return (TXURING *)0;
+}
+
+
+void txuFlush(TXURING *txu)
+{
+    // Submit any pending entries and wait for all datagrams in flight
+    txuSubmit(txu);
+    while(txu->freeCnt < txu->slotCount)
+    {
+        reapCompletions(txu);
+        if(txu->freeCnt >= txu->slotCount) break;
+        if(uringEnter(txu->fdRing, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) break;
+    }
+}
+
+
+void txuClose(TXURING *txu)
+{
+    if(!txu) return;
+
+    txuFlush(txu);
+    releaseRing(txu);
+}
+
+
+int txuQueue(TXURING *txu, const void *buffer, unsigned length)
+{
+    if(length > TXURING_SLOT_SIZE) return -1;
+
+    // Get a free slot. Harvest completions / wait only if all slots are in flight.
+    if(txu->freeCnt == 0) reapCompletions(txu);
+    while(txu->freeCnt == 0)
+    {
+        if(txuSubmit(txu)) return -1;
+        if(uringEnter(txu->fdRing, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+        {
+            idnLogError("[TXU] io_uring_enter() failed (error: %d)", errno);
+            return -1;
+        }
+        reapCompletions(txu);
+    }
+    unsigned slot = txu->freeSlots[--txu->freeCnt];
+
+    unsigned inFlight = txu->slotCount - txu->freeCnt;
+    if(inFlight > txu->stats.inFlightMax) txu->stats.inFlightMax = inFlight;
+
+    // Copy the datagram into the registered buffer
+    uint8_t *slotPtr = &txu->slotMem[(size_t)slot * TXURING_SLOT_SIZE];
+    memcpy(slotPtr, buffer, length);
+
+    // Populate the submission queue entry
+    unsigned tail = *txu->sqTail;
+    unsigned index = tail & *txu->sqMask;
+    struct io_uring_sqe *sqe = &txu->sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->fd = txu->fdSocket;
+    sqe->addr = (uint64_t)(uintptr_t)slotPtr;
+    sqe->len = length;
+    sqe->user_data = slot;
+    if(txu->zeroCopy)
+    {
+        sqe->opcode = IORING_OP_SEND_ZC;
+        sqe->ioprio = IORING_RECVSEND_FIXED_BUF;
+        sqe->buf_index = (uint16_t)slot;
+    }
+    else
+    {
+        sqe->opcode = IORING_OP_SEND;
+    }
+
+    txu->sqArray[index] = index;
+    __atomic_store_n(txu->sqTail, tail + 1, __ATOMIC_RELEASE);
+    txu->sqPending++;
+
+    return 0;
+}
+
+
+int txuSubmit(TXURING *txu)
+{
+    // All datagrams of a frame with a single system call
+    while(txu->sqPending)
+    {
+        int rc = uringEnter(txu->fdRing, txu->sqPending, 0, 0);
+        if(rc < 0)
+        {
+            if(errno == EINTR) continue;
+            idnLogError("[TXU] io_uring_enter() failed (error: %d)", errno);
+            return -1;
+        }
+        txu->sqPending -= (unsigned)rc;
+        txu->stats.submitCnt++;
+    }
+
+    return 0;
+}
+
+
+void txuReap(TXURING *txu)
+{
+    reapCompletions(txu);
+}
+
+
+void txuGetStats(TXURING *txu, TXURING_STATS *stats)
+{
+    *stats = txu->stats;
+    stats->zeroCopy = txu->zeroCopy;
+}
+
+
+#else
+
+// -------------------------------------------------------------------------------------------------
+//  Stubs for platforms without io_uring
+// -------------------------------------------------------------------------------------------------
+
+TXURING *txuOpen(int fdSocket, unsigned slotCount, int zeroCopy)
+{
+    idnLogError("[TXU] io_uring not available on this platform");
+    return (TXURING *)0;
+}
+
+void txuClose(TXURING *txu) { }
+void txuFlush(TXURING *txu) { }
+int txuQueue(TXURING *txu, const void *buffer, unsigned length) { return -1; }
+int txuSubmit(TXURING *txu) { return -1; }
+void txuReap(TXURING *txu) { }
+void txuGetStats(TXURING *txu, TXURING_STATS *stats) { memset(stats, 0, sizeof(*stats)); }
+
+#endif
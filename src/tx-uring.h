@@ -0,0 +1,82 @@
+// -------------------------------------------------------------------------------------------------
+//  File tx-uring.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+#ifndef TX_URING_H
+#define TX_URING_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define TXURING_DEFAULT_SLOTS           64          // Number of datagrams in flight
+#define TXURING_SLOT_SIZE               0x10000     // Maximum datagram size
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct _TXURING TXURING;
+
+typedef struct
+{
+    uint64_t sendCnt;                       // Number of datagrams completed
+    uint64_t errorCnt;                      // Number of datagrams failed
+    uint64_t copiedCnt;                     // Zero-copy sends the kernel had to copy anyway
+    uint64_t submitCnt;                     // Number of submit system calls
+    unsigned inFlightMax;                   // Peak number of datagrams in flight
+    int lastError;                          // Last send error (errno)
+    int zeroCopy;                           // Zero-copy currently in use
+
+} TXURING_STATS;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+// Note: The socket must be connected (send without destination address)
+TXURING *txuOpen(int fdSocket, unsigned slotCount, int zeroCopy);
+void txuClose(TXURING *txu);
+void txuFlush(TXURING *txu);
+
+int txuQueue(TXURING *txu, const void *buffer, unsigned length);
+int txuSubmit(TXURING *txu);
+void txuReap(TXURING *txu);
+
+void txuGetStats(TXURING *txu, TXURING_STATS *stats);
+
+
+#endif
@@ -0,0 +1,317 @@
+// -------------------------------------------------------------------------------------------------
+//  File workpool.c
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+// Standard libraries
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+
+// Platform includes
+#if defined(_WIN32) || defined(WIN32)
+
+    #include <windows.h>
+
+    #include "plt-windows.h"
+
+#else
+
+    #include "plt-posix.h"
+
+#endif
+
+
+// Module header
+#include "workpool.h"
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct
+{
+    WORKPOOL_FUNC func;                     // Job function
+    void *context;                          // Job argument
+
+} WORKPOOL_JOB;
+
+
+typedef struct
+{
+    WORKPOOL *pool;                         // Pool the worker belongs to
+    unsigned index;                         // Worker number
+    PLT_THREAD thread;                      // Worker thread
+
+    // Job queue (ring). Note: Locked per queue, jobs are coarse (no lock-free deque needed).
+    PLT_MUTEX mutex;
+    WORKPOOL_JOB *jobs;
+    unsigned jobCap;                        // Ring capacity
+    unsigned head;                          // Oldest job (taken by the owner)
+    unsigned count;                         // Number of queued jobs
+
+    uint64_t jobCnt;                        // Number of jobs run
+    uint64_t stealCnt;                      // Number of jobs taken from other queues
+    int runFlag;                            // Thread started
+
+} WORKPOOL_WORKER;
+
+
+struct _WORKPOOL
+{
+    WORKPOOL_WORKER *workers;
+    unsigned workerCnt;
+    unsigned nextWorker;                    // Queue for the next submitted job
+
+    // Sleeping and completion
+    PLT_MUTEX mutex;
+    PLT_COND workCond;                      // Workers wait for jobs
+    PLT_COND doneCond;                      // wkpWait() waits for completion
+    unsigned queuedCnt;                     // Number of jobs in all queues
+    unsigned pendingCnt;                    // Number of jobs not completed yet
+    int stopFlag;                           // Workers shall terminate
+};
+
+
+// -------------------------------------------------------------------------------------------------
+//  Tools
+// -------------------------------------------------------------------------------------------------
+
+static int takeJob(WORKPOOL_WORKER *worker, int stealFlag, WORKPOOL_JOB *job)
+{
+    // Owner takes the oldest job, thieves the newest one
+    int rc = 0;
+    plt_mutexLock(&worker->mutex);
+    if(worker->count)
+    {
+        unsigned pos = stealFlag ? (worker->head + worker->count - 1) % worker->jobCap : worker->head;
+        *job = worker->jobs[pos];
+
+        if(!stealFlag) worker->head = (worker->head + 1) % worker->jobCap;
+        worker->count--;
+        rc = 1;
+    }
+    plt_mutexUnlock(&worker->mutex);
+
+    return rc;
+}
+
+
+static PLT_THREAD_RESULT PLT_THREAD_CALL workerThread(void *arg)
+{
+    WORKPOOL_WORKER *worker = (WORKPOOL_WORKER *)arg;
+    WORKPOOL *wkp = worker->pool;
+
+    while(1)
+    {
+        // Own queue first, then the other queues (starting with the next worker)
+        WORKPOOL_JOB job;
+        int found = takeJob(worker, 0, &job);
+        for(unsigned i = 1; !found && (i < wkp->workerCnt); i++)
+        {
+            found = takeJob(&wkp->workers[(worker->index + i) % wkp->workerCnt], 1, &job);
+            if(found) worker->stealCnt++;
+        }
+
+        if(found)
+        {
+            plt_mutexLock(&wkp->mutex);
+            wkp->queuedCnt--;
+            plt_mutexUnlock(&wkp->mutex);
+
+            job.func(job.context);
+            worker->jobCnt++;
+
+            plt_mutexLock(&wkp->mutex);
+            if(--wkp->pendingCnt == 0) plt_condSignal(&wkp->doneCond);
+            plt_mutexUnlock(&wkp->mutex);
+            continue;
+        }
+
+        // Nothing to do: Sleep until jobs are queued
+        plt_mutexLock(&wkp->mutex);
+        while(!wkp->queuedCnt && !wkp->stopFlag) plt_condWait(&wkp->workCond, &wkp->mutex);
+        int stopFlag = wkp->stopFlag && !wkp->queuedCnt;
+        plt_mutexUnlock(&wkp->mutex);
+
+        if(stopFlag) break;
+    }
+
+    return 0;
+}
+
+
+// -------------------------------------------------------------------------------------------------
+//  API functions
+// -------------------------------------------------------------------------------------------------
+
+WORKPOOL *wkpCreate(unsigned workerCnt)
+{
+    if(workerCnt == 0) workerCnt = 1;
+    if(workerCnt > WORKPOOL_MAX_WORKERS) workerCnt = WORKPOOL_MAX_WORKERS;
+
+    WORKPOOL *wkp = (WORKPOOL *)calloc(1, sizeof(WORKPOOL));
+    if(!wkp) return (WORKPOOL *)0;
+
+    wkp->workers = (WORKPOOL_WORKER *)calloc(workerCnt, sizeof(WORKPOOL_WORKER));
+    if(!wkp->workers) { free(wkp); return (WORKPOOL *)0; }
+
+    wkp->workerCnt = workerCnt;
+    plt_mutexInit(&wkp->mutex);
+    plt_condInit(&wkp->workCond);
+    plt_condInit(&wkp->doneCond);
+
+    for(unsigned i = 0; i < workerCnt; i++)
+    {
+        WORKPOOL_WORKER *worker = &wkp->workers[i];
+        worker->pool = wkp;
+        worker->index = i;
+        plt_mutexInit(&worker->mutex);
+    }
+
+    // Note: The queues are set up before any worker looks at them
+    for(unsigned i = 0; i < workerCnt; i++)
+    {
+        WORKPOOL_WORKER *worker = &wkp->workers[i];
+        if(plt_threadCreate(&worker->thread, workerThread, worker)) { wkpDestroy(wkp); return (WORKPOOL *)0; }
+        worker->runFlag = 1;
+    }
+
+    return wkp;
+}
+
+
+void wkpDestroy(WORKPOOL *wkp)
+{
+    if(!wkp) return;
+
+    // Workers finish the queued jobs, then terminate
+    plt_mutexLock(&wkp->mutex);
+    wkp->stopFlag = 1;
+    plt_condBroadcast(&wkp->workCond);
+    plt_mutexUnlock(&wkp->mutex);
+
+    // Note: All workers gone before the queues go away (the last ones still look at the others)
+    for(unsigned i = 0; i < wkp->workerCnt; i++)
+    {
+        if(wkp->workers[i].runFlag) plt_threadJoin(wkp->workers[i].thread);
+    }
+
+    for(unsigned i = 0; i < wkp->workerCnt; i++)
+    {
+        WORKPOOL_WORKER *worker = &wkp->workers[i];
+        plt_mutexDestroy(&worker->mutex);
+        if(worker->jobs) free(worker->jobs);
+    }
+
+    plt_condDestroy(&wkp->doneCond);
+    plt_condDestroy(&wkp->workCond);
+    plt_mutexDestroy(&wkp->mutex);
+    free(wkp->workers);
+    free(wkp);
+}
+
+
+int wkpSubmit(WORKPOOL *wkp, WORKPOOL_FUNC func, void *context)
+{
+    WORKPOOL_WORKER *worker = &wkp->workers[wkp->nextWorker];
+    wkp->nextWorker = (wkp->nextWorker + 1) % wkp->workerCnt;
+
+    // Count the job before it becomes visible (a worker can take and complete it right away)
+    plt_mutexLock(&wkp->mutex);
+    wkp->queuedCnt++;
+    wkp->pendingCnt++;
+    plt_mutexUnlock(&wkp->mutex);
+
+    plt_mutexLock(&worker->mutex);
+    if(worker->count == worker->jobCap)
+    {
+        // Grow the ring (unwrap the queued jobs)
+        unsigned jobCap = worker->jobCap ? 2 * worker->jobCap : 16;
+        WORKPOOL_JOB *jobs = (WORKPOOL_JOB *)malloc(jobCap * sizeof(WORKPOOL_JOB));
+        if(!jobs)
+        {
+            plt_mutexUnlock(&worker->mutex);
+
+            // Not queued after all
+            plt_mutexLock(&wkp->mutex);
+            wkp->queuedCnt--;
+            if(--wkp->pendingCnt == 0) plt_condSignal(&wkp->doneCond);
+            plt_mutexUnlock(&wkp->mutex);
+            return -1;
+        }
+
+        for(unsigned i = 0; i < worker->count; i++) jobs[i] = worker->jobs[(worker->head + i) % worker->jobCap];
+        if(worker->jobs) free(worker->jobs);
+        worker->jobs = jobs;
+        worker->jobCap = jobCap;
+        worker->head = 0;
+    }
+
+    WORKPOOL_JOB *job = &worker->jobs[(worker->head + worker->count) % worker->jobCap];
+    job->func = func;
+    job->context = context;
+    worker->count++;
+    plt_mutexUnlock(&worker->mutex);
+
+    // Wake up a worker (any worker takes the job)
+    plt_mutexLock(&wkp->mutex);
+    plt_condSignal(&wkp->workCond);
+    plt_mutexUnlock(&wkp->mutex);
+
+    return 0;
+}
+
+
+void wkpWait(WORKPOOL *wkp)
+{
+    plt_mutexLock(&wkp->mutex);
+    while(wkp->pendingCnt) plt_condWait(&wkp->doneCond, &wkp->mutex);
+    plt_mutexUnlock(&wkp->mutex);
+}
+
+
+void wkpGetStats(WORKPOOL *wkp, WORKPOOL_STATS *stats)
+{
+    memset(stats, 0, sizeof(WORKPOOL_STATS));
+    stats->workerCnt = wkp->workerCnt;
+    stats->jobMin = UINT64_MAX;
+
+    // Note: Consistent after wkpWait()
+    for(unsigned i = 0; i < wkp->workerCnt; i++)
+    {
+        WORKPOOL_WORKER *worker = &wkp->workers[i];
+        stats->jobCnt += worker->jobCnt;
+        stats->stealCnt += worker->stealCnt;
+        if(worker->jobCnt > stats->jobMax) stats->jobMax = worker->jobCnt;
+        if(worker->jobCnt < stats->jobMin) stats->jobMin = worker->jobCnt;
+    }
+}
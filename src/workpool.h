@@ -0,0 +1,80 @@
+// -------------------------------------------------------------------------------------------------
+//  File workpool.h
+//
+//  Copyright (c) 2026 DexLogic
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in all
+//  copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//  SOFTWARE.
+//
+// -------------------------------------------------------------------------------------------------
+//  Change History:
+//
+//  10/2026 DexLogic, created
+// -------------------------------------------------------------------------------------------------
+
+
+#ifndef WORKPOOL_H
+#define WORKPOOL_H
+
+
+// Standard libraries
+#include <stdint.h>
+
+
+// -------------------------------------------------------------------------------------------------
+//  Defines
+// -------------------------------------------------------------------------------------------------
+
+#define WORKPOOL_MAX_WORKERS            64
+
+
+// -------------------------------------------------------------------------------------------------
+//  Typedefs
+// -------------------------------------------------------------------------------------------------
+
+typedef struct _WORKPOOL WORKPOOL;
+
+typedef void (* WORKPOOL_FUNC)(void *context);
+
+typedef struct
+{
+    unsigned workerCnt;                     // Number of worker threads
+    uint64_t jobCnt;                        // Number of jobs run
+    uint64_t stealCnt;                      // Number of jobs taken from another worker's queue
+    uint64_t jobMax;                        // Maximum number of jobs run by one worker
+    uint64_t jobMin;                        // Minimum number of jobs run by one worker
+
+} WORKPOOL_STATS;
+
+
+// -------------------------------------------------------------------------------------------------
+//  Prototypes
+// -------------------------------------------------------------------------------------------------
+
+// Note: Jobs are spread round-robin over the worker queues. A worker runs its own jobs oldest first
+// and takes the newest job of another queue when its own queue is empty (work stealing).
+WORKPOOL *wkpCreate(unsigned workerCnt);
+void wkpDestroy(WORKPOOL *wkp);
+
+int wkpSubmit(WORKPOOL *wkp, WORKPOOL_FUNC func, void *context);
+void wkpWait(WORKPOOL *wkp);
+
+void wkpGetStats(WORKPOOL *wkp, WORKPOOL_STATS *stats);
+
+
+#endif